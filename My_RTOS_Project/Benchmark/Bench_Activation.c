@@ -0,0 +1,103 @@
+/*
+ * Bench_Activation.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Abdallah
+ */
+
+
+// Task activation latency against the number of created tasks
+// Build it instead of Src/main.c, then read Bench_ActivationCycles from the debugger
+// Each step should give (nearly) the same number of cycles, as the ready lists don't depend on the tasks count
+// Note: 100 tasks (with the idle task) need about 21K of RAM, more than the STM32F103C6 has,
+//       run it on a larger part or lower the last step
+//       Build it with -DMYRTOS_MAX_TASKS=100 (the scheduler table is sized by MYRTOS_Config.h)
+
+
+#include "Bench_Common.h"
+#include "Schedular.h"
+
+
+#define BENCH_STEPS_NUM				5
+#define BENCH_MAX_TASKS				99      // + Idle task = 100 tasks in the scheduler table
+#define BENCH_ITERATIONS			32
+#define BENCH_TASK_STACK_SIZE		128     // Bytes, the tasks never run
+
+#if MYRTOS_MAX_TASKS < (BENCH_MAX_TASKS + 1)
+#error "Bench_Activation.c needs -DMYRTOS_MAX_TASKS=100"
+#endif
+
+
+const uint32_t Bench_TasksSteps[BENCH_STEPS_NUM] = {5, 10, 25, 50, BENCH_MAX_TASKS};
+
+uint32_t Bench_ActivationCycles[BENCH_STEPS_NUM];    // Average cycles of one MYRTOS_Activate_Task for each step
+uint32_t Bench_TerminationCycles[BENCH_STEPS_NUM];   // Average cycles of one MYRTOS_Terminate_Task for each step
+
+Task_Config Bench_Tasks[BENCH_MAX_TASKS];
+
+
+void Bench_DummyTask()
+{
+	while(1);
+}
+
+
+int main(void)
+{
+	uint32_t TasksNum = 0, Step, i, Start, ActivationSum, TerminationSum;
+	Task_Config* P_Task;
+
+	HW_Init();
+
+	if(MYRTOS_Init() != NO_ERROR)
+		while(1);
+
+	Bench_CycleCounter_Init();
+
+	// The OS isn't started, so the SVC services update the ready lists only (no context switch)
+	for(Step=0 ; Step<BENCH_STEPS_NUM ; Step++)
+	{
+		// Create more tasks till reaching this step (spread over all the priorities)
+		for( ; TasksNum<Bench_TasksSteps[Step] ; TasksNum++)
+		{
+			Bench_Tasks[TasksNum].Stack_Size = BENCH_TASK_STACK_SIZE;
+			Bench_Tasks[TasksNum].P_TaskEntry = Bench_DummyTask;
+			Bench_Tasks[TasksNum].Priority = TasksNum % MYRTOS_IDLE_PRIORITY;
+
+			if(MYRTOS_Create_Task(&Bench_Tasks[TasksNum]) != NO_ERROR)
+				while(1);
+
+			// Half of the tasks are ready, so the ready lists aren't empty
+			if(TasksNum % 2)
+				MYRTOS_Activate_Task(&Bench_Tasks[TasksNum]);
+		}
+
+		// Activate/Terminate the last created task
+		P_Task = &Bench_Tasks[TasksNum - 1];
+		ActivationSum = 0;
+		TerminationSum = 0;
+
+		for(i=0 ; i<BENCH_ITERATIONS ; i++)
+		{
+			MYRTOS_Terminate_Task(P_Task);
+
+			Start = BENCH_CYCLES();
+			MYRTOS_Activate_Task(P_Task);
+			ActivationSum += BENCH_CYCLES() - Start;
+
+			Start = BENCH_CYCLES();
+			MYRTOS_Terminate_Task(P_Task);
+			TerminationSum += BENCH_CYCLES() - Start;
+
+			MYRTOS_Activate_Task(P_Task);
+		}
+
+		Bench_ActivationCycles[Step] = ActivationSum / BENCH_ITERATIONS;
+		Bench_TerminationCycles[Step] = TerminationSum / BENCH_ITERATIONS;
+	}
+
+	while(1)
+	{
+
+	}
+}
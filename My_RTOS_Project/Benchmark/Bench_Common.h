@@ -0,0 +1,102 @@
+/*
+ * Bench_Common.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Abdallah
+ */
+
+#ifndef BENCH_COMMON_H_
+#define BENCH_COMMON_H_
+
+#include "core_cm3.h"
+#include "Schedular.h"
+
+
+// 1: Don't use the DWT cycle counter (QEMU doesn't model it), count with SysTick instead
+#ifndef BENCH_NO_DWT
+#define BENCH_NO_DWT				0
+#endif
+
+
+typedef enum{
+	Bench_Source_DWT,        // Core cycles
+	Bench_Source_SysTick     // SysTick counts (core cycles on the board, virtual clock counts on QEMU)
+}Bench_CycleSource_t;
+
+// Each benchmark is one translation unit
+static Bench_CycleSource_t Bench_CycleSource = Bench_Source_DWT;
+
+
+// Current value of the cycle counter
+#define BENCH_CYCLES()				Bench_Cycles()
+
+
+/**================================================================
+ * @Fn                - Bench_SysTick_Counts
+ * @brief             - SysTick counts since the OS started
+ * @retval            - uint32_t: SystemTicks * TICKER_COUNTS_PER_TICK + counts of the current tick
+ * Note              - Only valid while the ticker runs at 1 tick per period (not in tickless idle)
+ */
+
+static inline uint32_t Bench_SysTick_Counts(void)
+{
+	uint32_t Ticks, Pending, Counts;
+
+	do{
+		Ticks = MYRTOS_Get_SystemTicks();
+		// Read before VAL: if set, VAL already wrapped and the tick isn't counted yet
+		Pending = SCB->ICSR & SCB_ICSR_PENDSTSET_Msk;
+		Counts = SysTick->LOAD - SysTick->VAL;
+	}while(Ticks != MYRTOS_Get_SystemTicks());
+
+	if(Pending)
+		Ticks++;
+
+	return (Ticks * TICKER_COUNTS_PER_TICK) + Counts;
+}
+
+
+static inline uint32_t Bench_Cycles(void)
+{
+	if(Bench_CycleSource == Bench_Source_DWT)
+		return DWT->CYCCNT;
+
+	return Bench_SysTick_Counts();
+}
+
+
+/**================================================================
+ * @Fn                - Bench_CycleCounter_Init
+ * @brief             - Enables the DWT cycle counter, falls back to SysTick if it doesn't count
+ * @retval            - None
+ * Note              - Must be called in privileged mode (before MYRTOS_START_OS),
+ *                     the SysTick fallback only counts after MYRTOS_START_OS
+ */
+
+static inline void Bench_CycleCounter_Init(void)
+{
+#if !BENCH_NO_DWT
+	uint32_t Start;
+
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	Start = DWT->CYCCNT;
+	__NOP();
+	__NOP();
+	__NOP();
+	__NOP();
+
+	if(DWT->CYCCNT != Start)
+	{
+		Bench_CycleSource = Bench_Source_DWT;
+		return;
+	}
+#endif
+
+	Bench_CycleSource = Bench_Source_SysTick;
+}
+
+
+#endif /* BENCH_COMMON_H_ */
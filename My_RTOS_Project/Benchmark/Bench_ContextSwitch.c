@@ -0,0 +1,123 @@
+/*
+ * Bench_ContextSwitch.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Abdallah
+ */
+
+
+// Context switch cost between two tasks of the same priority
+// Each task yields to the other one (round robin), so one switch is:
+// svc --> OS_SVC_Services --> MYRTOS_RoundRobin, Decide_WhatNextTask --> PendSV_Handler --> the other task
+// Build it instead of Src/main.c (with MYRTOS_PRIVILEGED_TASKS=1), then read Bench_Switch* from the debugger
+// Build it against an older revision of the kernel to get the cycles before a change
+
+
+#include "Bench_Common.h"
+#include "Schedular.h"
+
+#include "string.h"
+
+#if !MYRTOS_PRIVILEGED_TASKS
+#error "Build the benchmark with MYRTOS_PRIVILEGED_TASKS=1 (tasks read the DWT cycle counter)"
+#endif
+
+
+#define BENCH_SWITCHES_NUM			10000
+
+
+Task_Config Bench_TaskA, Bench_TaskB;
+
+volatile uint32_t Bench_Stamp;
+uint32_t Bench_SwitchesCount;
+uint32_t Bench_SwitchCyclesSum;
+uint32_t Bench_SwitchCyclesMin = 0xFFFFFFFF;
+uint32_t Bench_SwitchCyclesMax;
+uint32_t Bench_SwitchCyclesAverage;     // Result
+
+
+/**================================================================
+ * @Fn                - Bench_Switched
+ * @brief             - Accumulates the cycles of the switch that just happened
+ * @retval            - None
+ * Note              - The first switches (tasks entries) and the ones preempted by the tick are the max
+ */
+
+void Bench_Switched()
+{
+	uint32_t Cycles = BENCH_CYCLES() - Bench_Stamp;
+
+	if(Bench_SwitchesCount == BENCH_SWITCHES_NUM)
+		return;
+
+	Bench_SwitchCyclesSum += Cycles;
+	if(Cycles < Bench_SwitchCyclesMin)
+		Bench_SwitchCyclesMin = Cycles;
+	if(Cycles > Bench_SwitchCyclesMax)
+		Bench_SwitchCyclesMax = Cycles;
+
+	Bench_SwitchesCount++;
+	if(Bench_SwitchesCount == BENCH_SWITCHES_NUM)
+		Bench_SwitchCyclesAverage = Bench_SwitchCyclesSum / BENCH_SWITCHES_NUM;
+}
+
+
+void Bench_TaskA_Entry()
+{
+	while(1)
+	{
+		Bench_Stamp = BENCH_CYCLES();
+		MYRTOS_Yield();
+		Bench_Switched();
+	}
+}
+
+
+void Bench_TaskB_Entry()
+{
+	while(1)
+	{
+		Bench_Switched();
+		Bench_Stamp = BENCH_CYCLES();
+		MYRTOS_Yield();
+	}
+}
+
+
+int main(void)
+{
+	MYRTOS_errorID Error = NO_ERROR;
+
+	HW_Init();
+
+	if(MYRTOS_Init() != NO_ERROR)
+		while(1);
+
+	Bench_CycleCounter_Init();
+
+	Bench_TaskA.Stack_Size = 512;
+	Bench_TaskA.P_TaskEntry = Bench_TaskA_Entry;
+	Bench_TaskA.Priority = 1;
+	strcpy(Bench_TaskA.TaskName, "bench_A");
+
+	Bench_TaskB.Stack_Size = 512;
+	Bench_TaskB.P_TaskEntry = Bench_TaskB_Entry;
+	Bench_TaskB.Priority = 1;
+	strcpy(Bench_TaskB.TaskName, "bench_B");
+
+	Error += MYRTOS_Create_Task(&Bench_TaskA);
+	Error += MYRTOS_Create_Task(&Bench_TaskB);
+
+	if(Error != NO_ERROR)
+		while(1);
+
+	MYRTOS_Activate_Task(&Bench_TaskA);
+	MYRTOS_Activate_Task(&Bench_TaskB);
+
+	MYRTOS_START_OS();
+
+	while(1)
+	{
+
+	}
+}
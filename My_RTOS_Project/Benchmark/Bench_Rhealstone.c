@@ -0,0 +1,389 @@
+/*
+ * Bench_Rhealstone.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Abdallah
+ */
+
+
+// Rhealstone style figures of the kernel, each one is the min/avg/max of BENCH_ITERATIONS samples:
+// - Task switch       : Two tasks of the same priority yield to each other (round robin)
+// - Preemption        : A low priority task activates a higher priority one, till it runs
+// - Mutex shuffle     : MYRTOS_ReleaseMutex by the owner, till the waiter returns from MYRTOS_AcquireMutex
+// - Message latency   : FIFO_Enqeue by the sender, till the receiver (activated by the sender) dequeues it
+// - Interrupt latency : Pending an interrupt, till its handler runs
+// - Interrupt to task : Pending an interrupt, till the task activated by its handler runs
+//
+// QEMU (lm3s6965evb): make -C Benchmark run, the results are printed on UART0 (SysTick counts, no DWT)
+// Board: build it instead of Src/main.c (with MYRTOS_PRIVILEGED_TASKS=1), then read Bench_Results from the debugger
+
+
+#include "Bench_Common.h"
+#include "Schedular.h"
+#include "My_RTOS_FIFO.h"
+
+#include "string.h"
+
+#if !MYRTOS_PRIVILEGED_TASKS
+#error "Build the benchmark with MYRTOS_PRIVILEGED_TASKS=1 (tasks read the cycle counter and pend the interrupt)"
+#endif
+
+
+#define BENCH_ITERATIONS			1000
+
+// Priorities (0 is the highest), the main task is the low priority side of every test
+#define BENCH_MAIN_PRIORITY			10
+#define BENCH_SWITCH_PRIORITY		5
+#define BENCH_HIGH_PRIORITY			3
+#define BENCH_ISR_TASK_PRIORITY		1
+
+// Interrupt pended by software (IRQ 0), at the priority of SysTick and SVC so its handler can call the kernel
+#define BENCH_IRQn					Interrupt0_IRQn
+#define BENCH_IRQ_PRIORITY			OS_KERNEL_PRIORITY
+#ifdef BENCH_QEMU_LM3S6965
+#define BENCH_IRQHandler			GPIOPortA_Handler
+#else
+#define BENCH_IRQHandler			WWDG_IRQHandler
+#endif
+
+
+typedef struct{
+	uint32_t Count;
+	uint32_t Sum;
+	uint32_t Min;
+	uint32_t Max;
+	uint32_t Average;
+}Bench_Result_t;
+
+typedef enum{
+	Bench_TaskSwitch,
+	Bench_Preemption,
+	Bench_MutexShuffle,
+	Bench_MessageLatency,
+	Bench_InterruptLatency,
+	Bench_InterruptToTask,
+	Bench_ResultsNum
+}Bench_ResultID;
+
+const char* const Bench_Names[Bench_ResultsNum] = {
+	"task switch",
+	"preemption",
+	"mutex shuffle",
+	"message latency",
+	"interrupt latency",
+	"interrupt to task"
+};
+
+Bench_Result_t Bench_Results[Bench_ResultsNum];      // Results (read them from the debugger on the board)
+volatile uint8_t Bench_Done;
+
+
+Task_Config Bench_Main, Bench_SwitchA, Bench_SwitchB, Bench_High, Bench_Mutex, Bench_Receiver, Bench_IsrTask;
+
+Mutex_Config Bench_MutexShuffleMutex;
+
+FIFO_Buffer_t Bench_Fifo;
+FIFO_BUFFER(Bench_FifoBuffer, Task_Config*, 4);
+
+volatile uint32_t Bench_Stamp;
+volatile uint32_t Bench_IsrStamp;
+
+
+
+// Output of the results (UART0 on QEMU, nothing on the board)
+
+__attribute__((weak)) void Bench_Putc(char c)
+{
+	(void)c;
+}
+
+__attribute__((weak)) void Bench_Exit(void)
+{
+	while(1);
+}
+
+
+void Bench_Print(const char* Str)
+{
+	while(*Str)
+		Bench_Putc(*Str++);
+}
+
+void Bench_PrintNumber(uint32_t Number, uint8_t Width)
+{
+	char Digits[10];
+	uint8_t i = 0;
+
+	do{
+		Digits[i++] = '0' + (Number % 10);
+		Number /= 10;
+	}while(Number);
+
+	while(Width-- > i)
+		Bench_Putc(' ');
+	while(i)
+		Bench_Putc(Digits[--i]);
+}
+
+
+
+/**================================================================
+ * @Fn                - Bench_Sample
+ * @brief             - Adds one sample to a result
+ * @param [in]        - ID: The result
+ * @param [in]        - Cycles: The sample
+ * @retval            - 1 when the result has all its samples
+ * Note              - Samples preempted by the tick are the max
+ */
+
+uint8_t Bench_Sample(Bench_ResultID ID, uint32_t Cycles)
+{
+	Bench_Result_t* P_Result = &Bench_Results[ID];
+
+	if(P_Result->Count == BENCH_ITERATIONS)
+		return 1;
+
+	if((P_Result->Count == 0) || (Cycles < P_Result->Min))
+		P_Result->Min = Cycles;
+	if(Cycles > P_Result->Max)
+		P_Result->Max = Cycles;
+	P_Result->Sum += Cycles;
+	P_Result->Count++;
+
+	if(P_Result->Count == BENCH_ITERATIONS)
+	{
+		P_Result->Average = P_Result->Sum / BENCH_ITERATIONS;
+		return 1;
+	}
+
+	return 0;
+}
+
+
+
+// Task switch: each task yields to the other one, so the kernel switches to it (round robin)
+
+void Bench_SwitchA_Entry()
+{
+	// The peer joins the ready list behind this task
+	MYRTOS_Activate_Task(&Bench_SwitchB);
+
+	while(1)
+	{
+		Bench_Stamp = BENCH_CYCLES();
+		MYRTOS_Yield();
+
+		if(Bench_Sample(Bench_TaskSwitch, BENCH_CYCLES() - Bench_Stamp))
+		{
+			MYRTOS_Terminate_Task(&Bench_SwitchB);
+			MYRTOS_Terminate_Task(&Bench_SwitchA);
+		}
+	}
+}
+
+void Bench_SwitchB_Entry()
+{
+	while(1)
+	{
+		if(Bench_Sample(Bench_TaskSwitch, BENCH_CYCLES() - Bench_Stamp))
+		{
+			MYRTOS_Terminate_Task(&Bench_SwitchA);
+			MYRTOS_Terminate_Task(&Bench_SwitchB);
+		}
+
+		Bench_Stamp = BENCH_CYCLES();
+		MYRTOS_Yield();
+	}
+}
+
+
+
+// Preemption: runs each time it is activated by the main task, then terminates itself
+
+void Bench_High_Entry()
+{
+	while(1)
+	{
+		Bench_Sample(Bench_Preemption, BENCH_CYCLES() - Bench_Stamp);
+		MYRTOS_Terminate_Task(&Bench_High);
+	}
+}
+
+
+
+// Mutex shuffle: blocks on the mutex owned by the main task, gets it when the main task releases it
+
+void Bench_Mutex_Entry()
+{
+	while(1)
+	{
+		MYRTOS_AcquireMutex(&Bench_MutexShuffleMutex, &Bench_Mutex);
+		Bench_Sample(Bench_MutexShuffle, BENCH_CYCLES() - Bench_Stamp);
+
+		MYRTOS_ReleaseMutex(&Bench_MutexShuffleMutex);
+		MYRTOS_Terminate_Task(&Bench_Mutex);
+	}
+}
+
+
+
+// Message latency: the main task enqueues the message then activates the receiver
+
+void Bench_Receiver_Entry()
+{
+	Task_Config* Message;
+
+	while(1)
+	{
+		if(FIFO_Deqeue(&Bench_Fifo, &Message) == FIFO_No_Error)
+			Bench_Sample(Bench_MessageLatency, BENCH_CYCLES() - Bench_Stamp);
+
+		MYRTOS_Terminate_Task(&Bench_Receiver);
+	}
+}
+
+
+
+// Interrupt to task: the handler activates the task, it runs after the handler (PendSV)
+
+void BENCH_IRQHandler(void)
+{
+	Bench_IsrStamp = BENCH_CYCLES();
+	MYRTOS_Activate_Task(&Bench_IsrTask);
+}
+
+void Bench_IsrTask_Entry()
+{
+	while(1)
+	{
+		Bench_Sample(Bench_InterruptToTask, BENCH_CYCLES() - Bench_Stamp);
+		Bench_Sample(Bench_InterruptLatency, Bench_IsrStamp - Bench_Stamp);
+		MYRTOS_Terminate_Task(&Bench_IsrTask);
+	}
+}
+
+
+
+void Bench_Report()
+{
+	uint32_t i;
+
+	Bench_Print("MyRTOS Rhealstone benchmark, ");
+	Bench_PrintNumber(BENCH_ITERATIONS, 0);
+	Bench_Print((Bench_CycleSource == Bench_Source_DWT) ? " iterations (DWT cycles)\n" : " iterations (SysTick counts)\n");
+	Bench_Print("test                     min       avg       max\n");
+
+	for(i=0 ; i<Bench_ResultsNum ; i++)
+	{
+		Bench_Print(Bench_Names[i]);
+		Bench_PrintNumber(Bench_Results[i].Min, 23 - strlen(Bench_Names[i]));
+		Bench_PrintNumber(Bench_Results[i].Average, 10);
+		Bench_PrintNumber(Bench_Results[i].Max, 10);
+		Bench_Putc('\n');
+	}
+}
+
+
+
+// Runs the tests one after the other (the lowest priority of the benchmark tasks)
+
+void Bench_Main_Entry()
+{
+	Task_Config* P_Sender = &Bench_Main;
+	uint32_t i;
+
+	// Task switch (the two tasks terminate themselves at the end)
+	MYRTOS_Activate_Task(&Bench_SwitchA);
+
+	// Preemption
+	for(i=0 ; i<BENCH_ITERATIONS ; i++)
+	{
+		Bench_Stamp = BENCH_CYCLES();
+		MYRTOS_Activate_Task(&Bench_High);
+	}
+
+	// Mutex shuffle
+	for(i=0 ; i<BENCH_ITERATIONS ; i++)
+	{
+		MYRTOS_AcquireMutex(&Bench_MutexShuffleMutex, &Bench_Main);
+		MYRTOS_Activate_Task(&Bench_Mutex);      // Runs till it blocks on the mutex
+
+		Bench_Stamp = BENCH_CYCLES();
+		MYRTOS_ReleaseMutex(&Bench_MutexShuffleMutex);
+	}
+
+	// Message latency (the message is a pointer to the sender)
+	for(i=0 ; i<BENCH_ITERATIONS ; i++)
+	{
+		Bench_Stamp = BENCH_CYCLES();
+		FIFO_Enqeue(&Bench_Fifo, &P_Sender);
+		MYRTOS_Activate_Task(&Bench_Receiver);
+	}
+
+	// Interrupt latency, interrupt to task
+	NVIC_SetPriority(BENCH_IRQn, BENCH_IRQ_PRIORITY);
+	NVIC_EnableIRQ(BENCH_IRQn);
+	for(i=0 ; i<BENCH_ITERATIONS ; i++)
+	{
+		Bench_Stamp = BENCH_CYCLES();
+		NVIC_SetPendingIRQ(BENCH_IRQn);
+	}
+	NVIC_DisableIRQ(BENCH_IRQn);
+
+	Bench_Done = 1;
+	Bench_Report();
+	Bench_Exit();
+
+	while(1)
+	{
+		MYRTOS_Terminate_Task(&Bench_Main);
+	}
+}
+
+
+
+void Bench_Create(Task_Config* taskReference, void (*P_TaskEntry)(void), uint8_t Priority, const char* Name, MYRTOS_errorID* P_Error)
+{
+	taskReference->Stack_Size = 512;
+	taskReference->P_TaskEntry = P_TaskEntry;
+	taskReference->Priority = Priority;
+	strcpy(taskReference->TaskName, Name);
+
+	*P_Error += MYRTOS_Create_Task(taskReference);
+}
+
+
+int main(void)
+{
+	MYRTOS_errorID Error = NO_ERROR;
+
+	HW_Init();
+
+	if(MYRTOS_Init() != NO_ERROR)
+		while(1);
+
+	Bench_CycleCounter_Init();
+
+	strcpy(Bench_MutexShuffleMutex.MutexName, "bench_mutex");
+	FIFO_Init(&Bench_Fifo, Bench_FifoBuffer, sizeof(Task_Config*), 4);
+
+	Bench_Create(&Bench_Main, Bench_Main_Entry, BENCH_MAIN_PRIORITY, "bench_main", &Error);
+	Bench_Create(&Bench_SwitchA, Bench_SwitchA_Entry, BENCH_SWITCH_PRIORITY, "bench_switchA", &Error);
+	Bench_Create(&Bench_SwitchB, Bench_SwitchB_Entry, BENCH_SWITCH_PRIORITY, "bench_switchB", &Error);
+	Bench_Create(&Bench_High, Bench_High_Entry, BENCH_HIGH_PRIORITY, "bench_high", &Error);
+	Bench_Create(&Bench_Mutex, Bench_Mutex_Entry, BENCH_HIGH_PRIORITY, "bench_mutex", &Error);
+	Bench_Create(&Bench_Receiver, Bench_Receiver_Entry, BENCH_HIGH_PRIORITY, "bench_receiver", &Error);
+	Bench_Create(&Bench_IsrTask, Bench_IsrTask_Entry, BENCH_ISR_TASK_PRIORITY, "bench_isr", &Error);
+
+	if(Error != NO_ERROR)
+		while(1);
+
+	MYRTOS_Activate_Task(&Bench_Main);
+
+	MYRTOS_START_OS();
+
+	while(1)
+	{
+
+	}
+}
@@ -0,0 +1,111 @@
+/*
+ * startup_lm3s6965evb.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Abdallah
+ */
+
+
+// Startup of the benchmark on QEMU's lm3s6965evb machine: vector table, reset, UART0 output, exit of QEMU
+
+
+#include <stdint.h>
+
+
+extern int _estack;
+extern uint32_t _sidata, _sdata, _edata, _sbss, _ebss;
+
+int main(void);
+
+
+// UART0 of the LM3S6965 (QEMU connects it to stdio with -nographic)
+#define UART0_DR					(*(volatile uint32_t*)0x4000C000)
+#define UART0_FR					(*(volatile uint32_t*)0x4000C018)
+#define UART0_CTL					(*(volatile uint32_t*)0x4000C030)
+#define UART_FR_TXFF				(1U << 5)
+#define UART_CTL_UARTEN_TXE			0x0101U
+
+// Semihosting (QEMU -semihosting-config enable=on)
+#define SEMIHOSTING_SYS_EXIT		0x18
+#define SEMIHOSTING_EXIT_OK			0x20026    // ADP_Stopped_ApplicationExit
+
+
+
+void Default_Handler(void)
+{
+	while(1);
+}
+
+// Exceptions not handled by the kernel / the benchmark
+void NMI_Handler(void) __attribute__((weak, alias("Default_Handler")));
+void DebugMon_Handler(void) __attribute__((weak, alias("Default_Handler")));
+void GPIOPortA_Handler(void) __attribute__((weak, alias("Default_Handler")));
+
+// CortexMxOS_Porting.c
+void HardFault_Handler(void);
+void MemManage_Handler(void);
+void BusFault_Handler(void);
+void UsageFault_Handler(void);
+void SVC_Handler(void);
+void PendSV_Handler(void);
+void SysTick_Handler(void);
+
+
+
+void Reset_Handler(void)
+{
+	uint32_t *P_Src = &_sidata, *P_Dst = &_sdata;
+
+	// Copy the data segment initializers from flash to SRAM
+	while(P_Dst < &_edata)
+		*P_Dst++ = *P_Src++;
+
+	// Zero fill the bss segment
+	for(P_Dst = &_sbss ; P_Dst < &_ebss ; P_Dst++)
+		*P_Dst = 0;
+
+	UART0_CTL = UART_CTL_UARTEN_TXE;
+
+	main();
+
+	while(1);
+}
+
+
+
+// 16 exceptions + 43 interrupts of the LM3S6965 (only IRQ 0 is used, by the benchmark)
+__attribute__((section(".isr_vector"), used)) void (* const Vectors[16 + 43])(void) = {
+	[0] = (void (*)(void))&_estack,
+	[1] = Reset_Handler,
+	[2] = NMI_Handler,
+	[3] = HardFault_Handler,
+	[4] = MemManage_Handler,
+	[5] = BusFault_Handler,
+	[6] = UsageFault_Handler,
+	[11] = SVC_Handler,
+	[12] = DebugMon_Handler,
+	[14] = PendSV_Handler,
+	[15] = SysTick_Handler,
+	[16 ... (16 + 43 - 1)] = Default_Handler,
+	[16] = GPIOPortA_Handler,
+};
+
+
+
+// Output of Bench_Rhealstone.c
+
+void Bench_Putc(char c)
+{
+	while(UART0_FR & UART_FR_TXFF);
+	UART0_DR = (uint32_t)c;
+}
+
+void Bench_Exit(void)
+{
+	register uint32_t r0 __asm("r0") = SEMIHOSTING_SYS_EXIT;
+	register uint32_t r1 __asm("r1") = SEMIHOSTING_EXIT_OK;
+
+	__asm volatile("bkpt #0xAB" : : "r"(r0), "r"(r1) : "memory");
+
+	while(1);
+}
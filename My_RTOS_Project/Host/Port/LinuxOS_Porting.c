@@ -0,0 +1,322 @@
+/*
+ * LinuxOS_Porting.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Abdallah
+ */
+
+#define _GNU_SOURCE
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <ucontext.h>
+
+#include "Schedular.h"
+#include "Schedular_Private.h"
+#include "My_RTOS_Profiler.h"
+
+
+
+uint8_t Host_RAM[HOST_RAM_SIZE];
+
+
+// Context of a task (pointed to by its Current_PSP)
+typedef struct Host_TaskContext{
+	ucontext_t Context;
+	uint8_t Stack[HOST_TASK_STACK_SIZE];
+	struct Host_TaskContext* P_NextFree;
+}Host_TaskContext_t;
+
+// Contexts of deleted tasks, reused by the next tasks created
+Host_TaskContext_t* Host_FreeContexts;
+
+
+// The first two members of OS_Control in Schedular.c (their offsets are checked there)
+extern struct{
+	Task_Config* CurrentTaskExecuted;
+	Task_Config* NextTaskTobeExecuted;
+}OS_Control;
+
+
+volatile uint8_t Host_PendSV_Pending;
+
+// Exception number of the running tick / interrupt (0: a task runs), as the IPSR register
+volatile uint32_t Host_IPSR;
+
+
+
+// Hooks for the time source (Sim/ records the timeline and the response times), nothing by default
+
+__attribute__((weak)) void Host_TaskCreated_Hook(Task_Config* P_Task)
+{
+	(void)P_Task;
+}
+
+__attribute__((weak)) void Host_ServiceDone_Hook(Task_Config* P_Caller, void* Argument)
+{
+	(void)P_Caller;
+	(void)Argument;
+}
+
+__attribute__((weak)) void Host_ContextSwitch_Hook(Task_Config* P_Current, Task_Config* P_Next)
+{
+	(void)P_Current;
+	(void)P_Next;
+}
+
+__attribute__((weak)) void Host_Tick_Hook(void)
+{
+}
+
+
+
+/**================================================================
+ * @Fn					- PendSV_Handler
+ * @brief 				- Switches context from OS_Control.CurrentTaskExecuted to OS_Control.NextTaskTobeExecuted
+ * @param [in] 			- None
+ * @retval 				- None
+ * Note					- Runs at the end of the SVC / tick (interrupts masked), the current task continues
+ * 						 from here when it is switched in again
+ */
+
+void PendSV_Handler(void)
+{
+	Task_Config *P_Current, *P_Next;
+
+	if(!Host_PendSV_Pending)
+		return;
+	Host_PendSV_Pending = 0;
+
+	P_Current = OS_Control.CurrentTaskExecuted;
+	P_Next = OS_Control.NextTaskTobeExecuted;
+
+	if(P_Next == NULL)
+		return;
+	OS_Control.NextTaskTobeExecuted = NULL;
+
+#if MYRTOS_PENDSV_HOOK
+	MYRTOS_PendSV_Hook(P_Current, P_Next);
+#endif
+
+	if(P_Next == P_Current)
+		return;
+
+	Host_ContextSwitch_Hook(P_Current, P_Next);
+
+	OS_Control.CurrentTaskExecuted = P_Next;
+	swapcontext(&((Host_TaskContext_t*)P_Current->Current_PSP)->Context, &((Host_TaskContext_t*)P_Next->Current_PSP)->Context);
+}
+
+
+
+/**================================================================
+ * @Fn					- Host_SVC
+ * @brief 				- Executes an OS service as the svc instruction would do
+ * @param [in] 			- ID: The service (stacked r12)
+ * @param [in] 			- Arg0..Arg3: Its arguments (stacked r0-r3)
+ * @retval 				- The result of the service (stacked r0 written by the kernel)
+ * Note					- The frame has the same layout as the Cortex-M exception frame. Called by an interrupt
+ * 						 (Host_IRQ), its xpsr holds the exception number and the context switch waits till it returns
+ */
+
+uintptr_t Host_SVC(uint32_t ID, uintptr_t Arg0, uintptr_t Arg1, uintptr_t Arg2, uintptr_t Arg3)
+{
+	// r0,r1,r2,r3,r12,lr,pc,xpsr
+	uintptr_t StackFrame[8] = {Arg0, Arg1, Arg2, Arg3, ID, 0, 0, Host_IPSR};
+	sigset_t OldMask;
+	Task_Config* P_Caller = OS_Control.CurrentTaskExecuted;
+
+	Host_Disable_Interrupts(&OldMask);
+
+	OS_SVC_Services(StackFrame);
+	Host_ServiceDone_Hook(P_Caller, (void*)Arg0);
+	if(Host_IPSR == 0)
+		PendSV_Handler();
+
+	Host_Restore_Interrupts(&OldMask);
+
+	return StackFrame[0];
+}
+
+
+
+void Trigger_OS_PendSV()
+{
+	Host_PendSV_Pending = 1;
+}
+
+
+
+/**================================================================
+ * @Fn					- Host_Tick
+ * @brief 				- Same job as SysTick_Handler of the Cortex-M port, called by the time source on each tick
+ * @param [in] 			- InterruptedPC: PC of the code the tick interrupted (sampled by the profiler), 0 if unknown
+ * @retval 				- None
+ * Note					- Runs on the stack of the interrupted task (interrupts masked), which continues from here
+ * 						 when it is switched in again
+ */
+
+void Host_Tick(uint32_t InterruptedPC)
+{
+	uint32_t TicksNum = Ticker_PeriodTicks;
+
+	Host_IPSR = HOST_SYSTICK_EXCEPTION;
+
+#if MYRTOS_USE_PROFILER
+	// The kernel masks the tick, so it always interrupts a task
+	MYRTOS_Profiler_Sample(InterruptedPC, 0, TicksNum);
+#else
+	(void)InterruptedPC;
+#endif
+
+	// Back to one tick period after a tickless idle period
+	Ticker_PeriodTicks = 1;
+
+	MYRTOS_Update_Tasks_WaitingTime(TicksNum);
+	MYRTOS_RoundRobin();
+	Decide_WhatNextTask();
+	Trigger_OS_PendSV();
+
+	Host_Tick_Hook();
+
+#if MYRTOS_TICKLESS_IDLE
+	Ticker_Suppress(MYRTOS_Get_IdleTicks());
+#endif
+
+	Host_IPSR = 0;
+	PendSV_Handler();
+}
+
+
+
+/**================================================================
+ * @Fn					- Host_IRQ
+ * @brief 				- Runs P_Handler as the interrupt IRQn (at the priority of the tick, as OS_KERNEL_PRIORITY
+ * 						 on the Cortex-M port), the services it calls take their interrupt path
+ * @param [in] 			- IRQn: Number of the interrupt (exception number - 16)
+ * @param [in] 			- P_Handler: The interrupt handler
+ * @retval 				- None
+ * Note					- Called by the time source, also from the tick (Host_Tick_Hook) when both are due. The context
+ * 						 switch asked by the handler happens when it returns to a task (PendSV tail-chaining)
+ */
+
+void Host_IRQ(uint16_t IRQn, void (*P_Handler)(void))
+{
+	uint32_t InterruptedIPSR = Host_IPSR;
+	sigset_t OldMask;
+
+	Host_Disable_Interrupts(&OldMask);
+
+	Host_IPSR = (uint32_t)IRQn + 16;
+	P_Handler();
+	Host_IPSR = InterruptedIPSR;
+
+	if(Host_IPSR == 0)
+		PendSV_Handler();
+
+	Host_Restore_Interrupts(&OldMask);
+}
+
+
+
+/**================================================================
+ * @Fn					- MYRTOS_Create_Stack
+ * @brief 				- Creates the context of a task, it starts at its P_TaskEntry
+ * @param [in] 			- taskReference: Pointer to the task configuration structure
+ * @retval 				- None
+ * Note					- Current_PSP points to the host context, the carved process stack isn't used
+ */
+
+void MYRTOS_Create_Stack(Task_Config* taskReference)
+{
+	Host_TaskContext_t* P_Context = Host_FreeContexts;
+
+	if(P_Context != NULL)
+		Host_FreeContexts = P_Context->P_NextFree;
+	else
+		P_Context = malloc(sizeof(Host_TaskContext_t));
+
+	if(P_Context == NULL)
+	{
+		fprintf(stderr, "MyRTOS host: no memory for the context of the task (priority %u)\n", taskReference->Priority);
+		exit(EXIT_FAILURE);
+	}
+
+	getcontext(&P_Context->Context);
+	P_Context->Context.uc_stack.ss_sp = P_Context->Stack;
+	P_Context->Context.uc_stack.ss_size = sizeof(P_Context->Stack);
+	P_Context->Context.uc_link = NULL;
+	// Tasks start with interrupts enabled
+	sigemptyset(&P_Context->Context.uc_sigmask);
+	makecontext(&P_Context->Context, taskReference->P_TaskEntry, 0);
+
+	taskReference->Current_PSP = (uint32_t*)P_Context;
+
+	Host_TaskCreated_Hook(taskReference);
+}
+
+
+
+#if MYRTOS_USE_TASK_DELETE
+/**================================================================
+ * @Fn					- MYRTOS_Delete_Stack
+ * @brief 				- Keeps the context of a deleted task for the next task created
+ * @param [in] 			- taskReference: Pointer to the task configuration structure
+ * @retval 				- None
+ * Note					- Not freed: a task deleting itself is still switched out on it (PendSV_Handler)
+ */
+
+void MYRTOS_Delete_Stack(Task_Config* taskReference)
+{
+	Host_TaskContext_t* P_Context = (Host_TaskContext_t*)taskReference->Current_PSP;
+
+	P_Context->P_NextFree = Host_FreeContexts;
+	Host_FreeContexts = P_Context;
+}
+#endif
+
+
+
+/**================================================================
+ * @Fn					- Start_FirstTask
+ * @brief 				- Runs the first task (Idle task) on its context
+ * @param [in] 			- taskReference: The first task
+ * @retval 				- None
+ * Note					- Never returns
+ */
+
+void Start_FirstTask(Task_Config* taskReference)
+{
+	Host_ContextSwitch_Hook(NULL, taskReference);
+
+	setcontext(&((Host_TaskContext_t*)taskReference->Current_PSP)->Context);
+
+	fprintf(stderr, "MyRTOS host: can't start the task (priority %u)\n", taskReference->Priority);
+	exit(EXIT_FAILURE);
+}
+
+
+
+
+
+
+/**================================================================
+ * @Fn					- HW_Init
+ * @brief 				- Checks the process stacks region, then initializes the time source
+ * @param [in] 			- None
+ * @retval 				- None
+ * Note					- None
+ */
+
+void HW_Init()
+{
+	// Addresses of the process stacks region are kept in uint32_t by the kernel
+	if((uintptr_t)(Host_RAM + HOST_RAM_SIZE) > 0xFFFFFFFFUL)
+	{
+		fprintf(stderr, "MyRTOS host: link with -no-pie (Host_RAM is above 4G)\n");
+		exit(EXIT_FAILURE);
+	}
+
+	Host_Ticker_Init();
+}
@@ -0,0 +1,239 @@
+/*
+ * LinuxOS_Ticker.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Abdallah
+ */
+
+// Real time source of the host port: the tick is SIGALRM from a 1ms interval timer
+// (Sim/ replaces this file with a virtual time source)
+
+#define _GNU_SOURCE
+
+#include <signal.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <time.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+#include "Schedular.h"
+#include "Schedular_Private.h"
+
+
+
+sigset_t Host_TickSignal;				// SIGALRM, masked while the kernel runs
+uint32_t Ticker_PeriodTicks = 1;		// Ticks covered by the current timer period (more than one during tickless idle)
+
+uint8_t SystTickIndication;
+
+
+
+/**================================================================
+ * @Fn					- Host_Disable_Interrupts
+ * @brief 				- Masks the tick signal (As if cpsid i)
+ * @param [out] 		- P_OldMask: Mask to be restored by Host_Restore_Interrupts
+ * @retval 				- None
+ * Note					- None
+ */
+
+void Host_Disable_Interrupts(sigset_t* P_OldMask)
+{
+	sigprocmask(SIG_BLOCK, &Host_TickSignal, P_OldMask);
+}
+
+void Host_Restore_Interrupts(sigset_t* P_OldMask)
+{
+	sigprocmask(SIG_SETMASK, P_OldMask, NULL);
+}
+
+
+
+/**================================================================
+ * @Fn					- Host_WaitForInterrupt
+ * @brief 				- Sleeps till the next signal (As if wfi)
+ * @param [in] 			- None
+ * @retval 				- None
+ * Note					- None
+ */
+
+void Host_WaitForInterrupt()
+{
+	pause();
+}
+
+
+
+/**================================================================
+ * @Fn					- Host_Get_Cycles
+ * @brief 				- Cycle counter of the run time statistics (As if DWT->CYCCNT)
+ * @param [in] 			- None
+ * @retval 				- Microseconds of the monotonic clock (wraps after 71 minutes)
+ * Note					- None
+ */
+
+uint32_t Host_Get_Cycles()
+{
+	struct timespec Now;
+
+	clock_gettime(CLOCK_MONOTONIC, &Now);
+
+	return (uint32_t)(((uint64_t)Now.tv_sec * 1000000U) + (Now.tv_nsec / 1000));
+}
+
+
+
+/**================================================================
+ * @Fn					- Host_Set_Timer
+ * @brief 				- Programs the next tick after FirstUs, then every HOST_TICK_US
+ * @param [in] 			- FirstUs: Microseconds till the next tick
+ * @retval 				- None
+ * Note					- None
+ */
+
+void Host_Set_Timer(uint32_t FirstUs)
+{
+	struct itimerval Timer;
+
+	Timer.it_value.tv_sec = FirstUs / 1000000;
+	Timer.it_value.tv_usec = FirstUs % 1000000;
+	Timer.it_interval.tv_sec = 0;
+	Timer.it_interval.tv_usec = HOST_TICK_US;
+
+	setitimer(ITIMER_REAL, &Timer, NULL);
+}
+
+
+
+void SysTick_Handler(int Signal, siginfo_t* P_Info, void* P_Context);
+
+
+/**================================================================
+ * @Fn					- Host_Ticker_Init
+ * @brief 				- Installs the tick signal handler (masked till the first task starts)
+ * @param [in] 			- None
+ * @retval 				- None
+ * Note					- Called by HW_Init
+ */
+
+void Host_Ticker_Init()
+{
+	struct sigaction Action = {0};
+
+	sigemptyset(&Host_TickSignal);
+	sigaddset(&Host_TickSignal, SIGALRM);
+	sigprocmask(SIG_BLOCK, &Host_TickSignal, NULL);
+
+	Action.sa_sigaction = SysTick_Handler;
+	Action.sa_flags = SA_RESTART | SA_SIGINFO;
+	sigemptyset(&Action.sa_mask);
+	sigaction(SIGALRM, &Action, NULL);
+}
+
+
+
+void Start_Ticker()
+{
+	Host_Set_Timer(HOST_TICK_US);
+}
+
+
+
+/**================================================================
+ * @Fn					- Ticker_Suppress
+ * @brief 				- Stretches the current timer period to TicksNum ticks (tickless idle).
+ * @param [in] 			- TicksNum: Number of ticks only the idle task will run
+ * @retval 				- None
+ * Note					- The timer interval stays 1ms, so the ticker goes back to 1ms by itself
+ */
+
+void Ticker_Suppress(uint32_t TicksNum)
+{
+	// Not worth stopping the ticker
+	if(TicksNum < 2)
+		return;
+
+	// Wake up at least every second
+	if(TicksNum > (1000000 / HOST_TICK_US))
+		TicksNum = 1000000 / HOST_TICK_US;
+
+	Host_Set_Timer(TicksNum * HOST_TICK_US);
+	Ticker_PeriodTicks = TicksNum;
+}
+
+
+
+/**================================================================
+ * @Fn					- Ticker_Resume
+ * @brief 				- Ends a tickless idle period before its time
+ * @param [in] 			- None
+ * @retval 				- Number of whole ticks passed since the period started
+ * Note					- The next tick is kept on a tick boundary
+ */
+
+uint32_t Ticker_Resume()
+{
+	struct itimerval Timer;
+	sigset_t Pending;
+	uint32_t RemainingUs, ElapsedUs;
+
+	sigpending(&Pending);
+
+	// Ticking normally, or the period already expired (SysTick_Handler will count it)
+	if((Ticker_PeriodTicks == 1) || sigismember(&Pending, SIGALRM))
+		return 0;
+
+	getitimer(ITIMER_REAL, &Timer);
+	RemainingUs = (Timer.it_value.tv_sec * 1000000) + Timer.it_value.tv_usec;
+	ElapsedUs = (Ticker_PeriodTicks * HOST_TICK_US) - RemainingUs;
+
+	Host_Set_Timer(HOST_TICK_US - (ElapsedUs % HOST_TICK_US));
+	Ticker_PeriodTicks = 1;
+
+	return ElapsedUs / HOST_TICK_US;
+}
+
+
+
+/**================================================================
+ * @Fn					- Host_Interrupted_PC
+ * @brief 				- PC of the code interrupted by a signal (As the stacked PC of an exception frame)
+ * @param [in] 			- P_Context: ucontext given to the signal handler
+ * @retval 				- The PC, 0 if it is outside the low 4G (shared libraries) or the host isn't supported
+ * Note					- The executable is linked at low addresses (-no-pie), so its code fits in 32 bits
+ */
+
+uint32_t Host_Interrupted_PC(void* P_Context)
+{
+	uintptr_t PC = 0;
+
+#if defined(__x86_64__)
+	PC = (uintptr_t)((ucontext_t*)P_Context)->uc_mcontext.gregs[REG_RIP];
+#elif defined(__aarch64__)
+	PC = (uintptr_t)((ucontext_t*)P_Context)->uc_mcontext.pc;
+#else
+	(void)P_Context;
+#endif
+
+	return (PC > 0xFFFFFFFFUL) ? 0 : (uint32_t)PC;
+}
+
+
+
+/**================================================================
+ * @Fn					- SysTick_Handler
+ * @brief 				- SIGALRM handler, same job as the SysTick interrupt
+ * @param [in] 			- Signal: SIGALRM
+ * @param [in] 			- P_Info: Not used, P_Context: ucontext of the interrupted code (the profiler samples its PC)
+ * @retval 				- None
+ * Note					- Runs on the stack of the interrupted task, which continues from here when switched in again
+ */
+
+void SysTick_Handler(int Signal, siginfo_t* P_Info, void* P_Context)
+{
+	(void)Signal;
+	(void)P_Info;
+	SystTickIndication ^= 1;
+
+	Host_Tick(Host_Interrupted_PC(P_Context));
+}
@@ -0,0 +1,99 @@
+/*
+ * LinuxOS_Porting.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Abdallah
+ */
+
+#ifndef INC_LINUXOS_PORTING_H_
+#define INC_LINUXOS_PORTING_H_
+
+#include "stdint.h"
+#include <signal.h>
+
+
+// Host (Linux user space) port of the kernel, it replaces CortexMxOS_Porting when MYRTOS_PORT_LINUX is defined
+// - SVC     --> Host_SVC() function call (interrupts masked)
+// - PendSV  --> swapcontext() at the end of the SVC / tick
+// - SysTick --> SIGALRM from a 1ms interval timer (LinuxOS_Ticker.c), or virtual time (Sim/)
+// - IRQs    --> Host_IRQ() raised by the time source (Sim/), IPSR --> Host_IPSR
+// - Tasks   --> ucontext with a host stack each
+
+
+// Process stacks region, the kernel carves the tasks stacks from it as from the MCU RAM
+// The kernel keeps addresses in uint32_t, so the executable is linked at low addresses (-no-pie)
+#define HOST_RAM_SIZE				(64 * 1024)
+extern uint8_t Host_RAM[HOST_RAM_SIZE];
+
+#define _estack						(*(int*)(Host_RAM + HOST_RAM_SIZE))
+#define _eheap						(*(int*)(Host_RAM))
+
+#define MainStackSize 2048  // 2K
+
+// Tasks run on their own host stacks (libc and signal frames don't fit in MCU sized stacks)
+#define HOST_TASK_STACK_SIZE		(64 * 1024)
+
+// 1ms tick
+#define HOST_TICK_US				1000
+
+// Exception number of SysTick (Host_IPSR while the tick runs)
+#define HOST_SYSTICK_EXCEPTION		15
+
+
+// Same result as the CLZ instruction (32 for 0)
+static inline uint8_t __CLZ(uint32_t value)
+{
+	if(value == 0U)
+		return 32U;
+	return __builtin_clz(value);
+}
+
+
+#define OS_SVC_CALL(ID, Arg0, Arg1, Arg2, Arg3)		Host_SVC((ID), (Arg0), (Arg1), (Arg2), (Arg3))
+
+#define OS_WAIT_FOR_INTERRUPT()		Host_WaitForInterrupt()
+
+// Run time statistics and trace (microseconds on the host)
+#define OS_GET_CYCLES()				Host_Get_Cycles()
+#define OS_CYCLES_PER_US			1
+#define OS_GET_IRQ_NUMBER()			((uint16_t)(Host_IPSR - 16))
+
+#define OS_MEMORY_BARRIER()			__atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+
+void HW_Init(void);
+
+void Trigger_OS_PendSV(void);
+
+void Start_Ticker(void);
+
+void Ticker_Suppress(uint32_t TicksNum);
+uint32_t Ticker_Resume(void);
+
+uintptr_t Host_SVC(uint32_t ID, uintptr_t Arg0, uintptr_t Arg1, uintptr_t Arg2, uintptr_t Arg3);
+void PendSV_Handler(void);
+void Host_Tick(uint32_t InterruptedPC);
+void Host_IRQ(uint16_t IRQn, void (*P_Handler)(void));
+
+// Exception number of the running tick / interrupt (0: a task runs)
+extern volatile uint32_t Host_IPSR;
+
+// Ticks covered by the current tick period (more than one during tickless idle), kept by the time source
+extern uint32_t Ticker_PeriodTicks;
+
+// Time source (LinuxOS_Ticker.c or Sim/)
+void Host_Ticker_Init(void);
+void Host_Disable_Interrupts(sigset_t* P_OldMask);
+void Host_Restore_Interrupts(sigset_t* P_OldMask);
+void Host_WaitForInterrupt(void);
+uint32_t Host_Get_Cycles(void);
+
+// Hooks (weak, nothing by default), called with interrupts masked
+struct Task_Config;
+void Host_TaskCreated_Hook(struct Task_Config* P_Task);
+void Host_ServiceDone_Hook(struct Task_Config* P_Caller, void* Argument);     // After the kernel, before the context switch (Argument: r0)
+void Host_ContextSwitch_Hook(struct Task_Config* P_Current, struct Task_Config* P_Next);
+void Host_Tick_Hook(void);                                                   // After the tick, before the context switch
+
+
+#endif /* INC_LINUXOS_PORTING_H_ */
@@ -0,0 +1,549 @@
+/*
+ * Sim.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Abdallah
+ */
+
+// Virtual time source of the host port (replaces Port/LinuxOS_Ticker.c)
+// Nothing is asynchronous: the tick and the raised interrupts run inside Sim_Work() or the idle task,
+// so masking interrupts does nothing
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+
+#include "Schedular.h"
+#include "Schedular_Private.h"
+#include "Sim.h"
+#include "My_RTOS_Trace.h"
+
+
+// The report names the tasks, the scenarios wait for time and share mutexes
+#if !MYRTOS_USE_TASK_NAMES || !MYRTOS_USE_TIMING_WAIT || !MYRTOS_USE_MUTEX
+#error "The simulator needs MYRTOS_USE_TASK_NAMES, MYRTOS_USE_TIMING_WAIT and MYRTOS_USE_MUTEX"
+#endif
+
+
+typedef struct{
+	Task_Config* P_Task;
+	uint8_t Priority;             // At creation (the running priority may be inherited)
+	uint8_t JobActive;
+	uint64_t ReleaseTime;
+	uint32_t Jobs;                // Completed jobs
+	uint64_t MinResponse;
+	uint64_t MaxResponse;
+	uint64_t SumResponse;
+	uint64_t CpuTime;
+}Sim_TaskStats_t;
+
+typedef struct{
+	uint64_t Time;
+	Task_Config* P_Task;          // Switched in at Time
+}Sim_Event_t;
+
+typedef struct{
+	uint64_t Time;
+	uint16_t IRQn;
+	void (*P_Handler)(void);
+}Sim_IRQ_t;
+
+
+Sim_TaskStats_t Sim_Tasks[SIM_MAX_TASKS];
+uint32_t Sim_TasksNum;
+
+Sim_Event_t Sim_Events[SIM_MAX_EVENTS];
+uint32_t Sim_EventsNum;
+uint32_t Sim_LostEvents;          // Context switches after the timeline was full
+Sim_IRQ_t Sim_IRQs[SIM_MAX_IRQS]; // Raised interrupts not run yet, in time order
+uint32_t Sim_IRQsNum;
+uint8_t Sim_Timeline = 1;
+const char* Sim_TraceFile;
+
+uint64_t Sim_Time;                // Virtual time (us)
+uint64_t Sim_PeriodStart;         // Time of the last tick
+uint64_t Sim_NextTick = HOST_TICK_US;
+uint64_t Sim_EndTime = 1000ULL * HOST_TICK_US;
+
+uint32_t Ticker_PeriodTicks = 1;  // Ticks covered by the current period (more than one during tickless idle)
+
+Task_Config* Sim_Current;
+
+
+
+Sim_TaskStats_t* Sim_Find(Task_Config* P_Task)
+{
+	uint32_t i;
+
+	for(i=0 ; i<Sim_TasksNum ; i++)
+	{
+		if(Sim_Tasks[i].P_Task == P_Task)
+			return &Sim_Tasks[i];
+	}
+
+	return NULL;
+}
+
+
+
+/**================================================================
+ * @Fn					- Sim_Update_Jobs
+ * @brief 				- Starts / ends the jobs of the tasks after the kernel ran (service or tick)
+ * @param [in] 			- Argument: Argument of the service (NULL for the tick)
+ * @retval 				- None
+ * Note					- A job ends when its task waits for time, or when the task itself is terminated,
+ * 						 a task blocked on a mutex is suspended too but its job goes on
+ */
+
+void Sim_Update_Jobs(void* Argument)
+{
+	uint32_t i;
+	uint64_t Response;
+	Sim_TaskStats_t* P_Stats;
+
+	for(i=0 ; i<Sim_TasksNum ; i++)
+	{
+		P_Stats = &Sim_Tasks[i];
+
+		if(!P_Stats->JobActive)
+		{
+			if(P_Stats->P_Task->Task_State != Suspend)
+			{
+				P_Stats->JobActive = 1;
+				P_Stats->ReleaseTime = Sim_Time;
+			}
+		}
+		else if((P_Stats->P_Task->Task_State == Suspend) &&
+				((P_Stats->P_Task->Time_Waiting.Block_Timing == Blocking_Enable) || (Argument == P_Stats->P_Task)))
+		{
+			P_Stats->JobActive = 0;
+			Response = Sim_Time - P_Stats->ReleaseTime;
+
+			if((P_Stats->Jobs == 0) || (Response < P_Stats->MinResponse))
+				P_Stats->MinResponse = Response;
+			if(Response > P_Stats->MaxResponse)
+				P_Stats->MaxResponse = Response;
+			P_Stats->SumResponse += Response;
+			P_Stats->Jobs++;
+		}
+	}
+}
+
+
+
+/**================================================================
+ * @Fn					- Sim_Report
+ * @brief 				- Prints the timeline and the statistics of each task
+ * @param [in] 			- None
+ * @retval 				- None
+ * Note					- Only integers are printed, so the report is the same on any machine
+ */
+
+void Sim_Report()
+{
+	uint32_t i;
+	uint64_t CpuPerMille;
+#if MYRTOS_USE_STATISTICS
+	uint32_t Utilization;
+#endif
+	Sim_TaskStats_t* P_Stats;
+
+	if(Sim_Timeline)
+	{
+		printf("Timeline (us)\n");
+		for(i=0 ; i<Sim_EventsNum ; i++)
+			printf("%10llu  %s\n", (unsigned long long)Sim_Events[i].Time, Sim_Events[i].P_Task->TaskName);
+		if(Sim_LostEvents)
+			printf("      ...   %u more context switches\n", Sim_LostEvents);
+		printf("\n");
+	}
+
+	printf("Simulated %llu us, %u context switches\n\n", (unsigned long long)Sim_Time, Sim_EventsNum + Sim_LostEvents);
+	printf("%-12s %4s %6s %9s %9s %9s %9s %7s", "Task", "Prio", "Jobs", "Min(us)", "Avg(us)", "Max(us)", "Jitter", "CPU(%)");
+#if MYRTOS_USE_STATISTICS
+	printf(" %9s", "Kernel(%)");     // Measured by the kernel (MYRTOS_Get_TaskUtilization), since the task was created last
+#endif
+	printf("\n");
+
+	for(i=0 ; i<Sim_TasksNum ; i++)
+	{
+		P_Stats = &Sim_Tasks[i];
+		CpuPerMille = (P_Stats->CpuTime * 1000) / Sim_Time;
+
+		printf("%-12s %4u %6u ", P_Stats->P_Task->TaskName, P_Stats->Priority, P_Stats->Jobs);
+
+		if(P_Stats->Jobs)
+		{
+			printf("%9llu %9llu %9llu %9llu ",
+					(unsigned long long)P_Stats->MinResponse,
+					(unsigned long long)(P_Stats->SumResponse / P_Stats->Jobs),
+					(unsigned long long)P_Stats->MaxResponse,
+					(unsigned long long)(P_Stats->MaxResponse - P_Stats->MinResponse));
+		}else{
+			printf("%9s %9s %9s %9s ", "-", "-", "-", "-");
+		}
+
+		printf("%5llu.%llu", (unsigned long long)(CpuPerMille / 10), (unsigned long long)(CpuPerMille % 10));
+#if MYRTOS_USE_STATISTICS
+		Utilization = MYRTOS_Get_TaskUtilization(P_Stats->P_Task);
+		printf(" %6u.%02u", Utilization / 100, Utilization % 100);
+#endif
+		printf("\n");
+	}
+}
+
+
+
+/**================================================================
+ * @Fn					- Sim_Write_Trace
+ * @brief 				- Writes MYRTOS_TraceBuffer to the trace file (as a dump of the target RAM)
+ * @param [in] 			- None
+ * @retval 				- None
+ * Note					- Decoded by Tools/myrtos_trace.py
+ */
+
+void Sim_Write_Trace()
+{
+#if MYRTOS_USE_TRACE
+	FILE* P_File;
+
+	if(Sim_TraceFile == NULL)
+		return;
+
+	P_File = fopen(Sim_TraceFile, "wb");
+	if((P_File == NULL) || (fwrite(&MYRTOS_TraceBuffer, sizeof(MYRTOS_TraceBuffer), 1, P_File) != 1))
+	{
+		fprintf(stderr, "MyRTOS sim: can't write %s\n", Sim_TraceFile);
+		exit(EXIT_FAILURE);
+	}
+	fclose(P_File);
+#endif
+}
+
+
+
+/**================================================================
+ * @Fn					- Sim_Tick
+ * @brief 				- Starts the next tick period when the virtual time reaches it, then runs the tick (Host_Tick)
+ * @param [in] 			- None
+ * @retval 				- None
+ * Note					- Runs in the context of the current task, which continues from here when switched in again
+ */
+
+void Sim_Tick()
+{
+	Sim_PeriodStart = Sim_NextTick;
+	Sim_NextTick = Sim_PeriodStart + HOST_TICK_US;
+
+	if(Sim_Time >= Sim_EndTime)
+	{
+		Sim_Report();
+		Sim_Write_Trace();
+		exit(EXIT_SUCCESS);
+	}
+
+	// Same path as the tick of the real time source (LinuxOS_Ticker.c), the virtual time has no interrupted PC
+	// (the profiler counts the samples of each task)
+	Host_Tick(0);
+}
+
+
+
+/**================================================================
+ * @Fn					- Sim_Run_IRQs
+ * @brief 				- Runs the raised interrupts due at the virtual time (Host_IRQ), in time order
+ * @param [in] 			- None
+ * @retval 				- None
+ * Note					- Each one is taken out first, so its handler can raise the next one
+ */
+
+void Sim_Run_IRQs()
+{
+	Sim_IRQ_t IRQ;
+
+	while((Sim_IRQsNum != 0) && (Sim_IRQs[0].Time <= Sim_Time))
+	{
+		IRQ = Sim_IRQs[0];
+		Sim_IRQsNum--;
+		memmove(&Sim_IRQs[0], &Sim_IRQs[1], Sim_IRQsNum * sizeof(Sim_IRQ_t));
+
+		Host_IRQ(IRQ.IRQn, IRQ.P_Handler);
+	}
+}
+
+
+
+// Virtual time of the next tick or raised interrupt (not before now)
+uint64_t Sim_Next_Event()
+{
+	uint64_t Next = Sim_NextTick;
+
+	if((Sim_IRQsNum != 0) && (Sim_IRQs[0].Time < Next))
+		Next = Sim_IRQs[0].Time;
+
+	return (Next > Sim_Time) ? Next : Sim_Time;
+}
+
+
+
+// The tick (it runs the interrupts due at the same time, SysTick comes first) or the interrupts due now
+void Sim_Run_Events()
+{
+	if(Sim_Time == Sim_NextTick)
+		Sim_Tick();
+	else
+		Sim_Run_IRQs();
+}
+
+
+
+void Sim_Advance(uint64_t Us)
+{
+	Sim_TaskStats_t* P_Stats = Sim_Find(Sim_Current);
+
+	if(P_Stats != NULL)
+		P_Stats->CpuTime += Us;
+
+	Sim_Time += Us;
+}
+
+
+
+/**================================================================
+ * @Fn					- Sim_Work
+ * @brief 				- Simulated work of the running task, the virtual time moves forward by Us
+ * @param [in] 			- Us: Microseconds of work
+ * @retval 				- None
+ * Note					- The ticks and the interrupts on the way run on time, the rest of the work is done
+ * 						 when the task is switched in again
+ */
+
+void Sim_Work(uint32_t Us)
+{
+	uint64_t Step;
+
+	while(Us != 0)
+	{
+		Step = Sim_Next_Event() - Sim_Time;
+		if(Step > Us)
+			Step = Us;
+
+		Sim_Advance(Step);
+		Us -= Step;
+
+		Sim_Run_Events();
+	}
+}
+
+
+
+/**================================================================
+ * @Fn					- Sim_Raise_IRQ
+ * @brief 				- Raises the interrupt IRQn at the virtual time TimeUs, P_Handler runs then (Host_IRQ)
+ * @param [in] 			- TimeUs: Virtual time of the interrupt (now if it is already passed)
+ * @param [in] 			- IRQn: Number of the interrupt (MYRTOS_TRACE_ISR_ENTER records it)
+ * @param [in] 			- P_Handler: The interrupt handler
+ * @retval 				- None
+ * Note					- Interrupts raised for the same time run in the order they were raised
+ */
+
+void Sim_Raise_IRQ(uint32_t TimeUs, uint16_t IRQn, void (*P_Handler)(void))
+{
+	uint32_t i;
+
+	if(Sim_IRQsNum == SIM_MAX_IRQS)
+	{
+		fprintf(stderr, "MyRTOS sim: more than %u raised interrupts\n", SIM_MAX_IRQS);
+		exit(EXIT_FAILURE);
+	}
+
+	for(i=Sim_IRQsNum ; (i != 0) && (Sim_IRQs[i-1].Time > TimeUs) ; i--)
+		Sim_IRQs[i] = Sim_IRQs[i-1];
+
+	Sim_IRQs[i].Time = TimeUs;
+	Sim_IRQs[i].IRQn = IRQn;
+	Sim_IRQs[i].P_Handler = P_Handler;
+	Sim_IRQsNum++;
+}
+
+
+
+uint64_t Sim_Get_Time()
+{
+	return Sim_Time;
+}
+
+void Sim_Log(const char* Format, ...)
+{
+	va_list Args;
+
+	printf("%10llu  ", (unsigned long long)Sim_Time);
+	va_start(Args, Format);
+	vprintf(Format, Args);
+	va_end(Args);
+	printf("\n");
+}
+
+void Sim_Set_Duration(uint32_t Ticks)
+{
+	Sim_EndTime = (uint64_t)Ticks * HOST_TICK_US;
+}
+
+void Sim_Set_Timeline(uint8_t Enable)
+{
+	Sim_Timeline = Enable;
+}
+
+void Sim_Set_TraceFile(const char* Path)
+{
+	Sim_TraceFile = Path;
+}
+
+
+
+// Time source of the host port
+
+void Host_Ticker_Init()
+{
+}
+
+void Host_Disable_Interrupts(sigset_t* P_OldMask)
+{
+	(void)P_OldMask;
+}
+
+void Host_Restore_Interrupts(sigset_t* P_OldMask)
+{
+	(void)P_OldMask;
+}
+
+// Run time statistics count virtual microseconds
+uint32_t Host_Get_Cycles()
+{
+	return (uint32_t)Sim_Time;
+}
+
+
+
+/**================================================================
+ * @Fn					- Host_WaitForInterrupt
+ * @brief 				- The idle task sleeps till the next tick or raised interrupt (As if wfi)
+ * @param [in] 			- None
+ * @retval 				- None
+ * Note					- None
+ */
+
+void Host_WaitForInterrupt()
+{
+	Sim_Advance(Sim_Next_Event() - Sim_Time);
+	Sim_Run_Events();
+}
+
+
+
+void Start_Ticker()
+{
+	Sim_PeriodStart = Sim_Time;
+	Sim_NextTick = Sim_Time + HOST_TICK_US;
+}
+
+
+
+/**================================================================
+ * @Fn					- Ticker_Suppress
+ * @brief 				- Stretches the current tick period to TicksNum ticks (tickless idle)
+ * @param [in] 			- TicksNum: Number of ticks only the idle task will run
+ * @retval 				- None
+ * Note					- The period doesn't go beyond the end of the simulation
+ */
+
+void Ticker_Suppress(uint32_t TicksNum)
+{
+	uint64_t TicksToEnd = (Sim_EndTime - Sim_PeriodStart) / HOST_TICK_US;
+
+	if(TicksNum > TicksToEnd)
+		TicksNum = TicksToEnd;
+
+	// Not worth stopping the ticker
+	if(TicksNum < 2)
+		return;
+
+	Sim_NextTick = Sim_PeriodStart + ((uint64_t)TicksNum * HOST_TICK_US);
+	Ticker_PeriodTicks = TicksNum;
+}
+
+
+
+/**================================================================
+ * @Fn					- Ticker_Resume
+ * @brief 				- Ends a tickless idle period before its time
+ * @param [in] 			- None
+ * @retval 				- Number of whole ticks passed since the period started
+ * Note					- The next tick is kept on a tick boundary
+ */
+
+uint32_t Ticker_Resume()
+{
+	uint32_t Elapsed;
+
+	if(Ticker_PeriodTicks == 1)
+		return 0;
+
+	Elapsed = (Sim_Time - Sim_PeriodStart) / HOST_TICK_US;
+
+	Sim_PeriodStart += (uint64_t)Elapsed * HOST_TICK_US;
+	Sim_NextTick = Sim_PeriodStart + HOST_TICK_US;
+	Ticker_PeriodTicks = 1;
+
+	return Elapsed;
+}
+
+
+
+// Hooks of the host port
+
+void Host_TaskCreated_Hook(Task_Config* P_Task)
+{
+	// Created again after MYRTOS_Delete_Task: it keeps its row
+	if(Sim_Find(P_Task) != NULL)
+		return;
+
+	if(Sim_TasksNum == SIM_MAX_TASKS)
+	{
+		fprintf(stderr, "MyRTOS sim: more than %u tasks\n", SIM_MAX_TASKS);
+		exit(EXIT_FAILURE);
+	}
+
+	Sim_Tasks[Sim_TasksNum].P_Task = P_Task;
+	Sim_Tasks[Sim_TasksNum].Priority = P_Task->Priority;
+	Sim_TasksNum++;
+}
+
+void Host_ServiceDone_Hook(Task_Config* P_Caller, void* Argument)
+{
+	(void)P_Caller;
+	Sim_Update_Jobs(Argument);
+}
+
+void Host_Tick_Hook()
+{
+	Sim_Update_Jobs(NULL);
+	Sim_Run_IRQs();
+}
+
+void Host_ContextSwitch_Hook(Task_Config* P_Current, Task_Config* P_Next)
+{
+	(void)P_Current;
+	Sim_Current = P_Next;
+
+	if(Sim_EventsNum < SIM_MAX_EVENTS)
+	{
+		Sim_Events[Sim_EventsNum].Time = Sim_Time;
+		Sim_Events[Sim_EventsNum].P_Task = P_Next;
+		Sim_EventsNum++;
+	}else{
+		Sim_LostEvents++;
+	}
+}
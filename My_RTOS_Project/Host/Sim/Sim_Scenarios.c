@@ -0,0 +1,1360 @@
+/*
+ * Sim_Scenarios.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Abdallah
+ */
+
+
+// Scenarios replayed by the simulator
+//   myrtos_sim <scenario> [-q] [-t <file>]
+//   (-q: statistics only, without the timeline, -t: writes the scheduler trace to <file>, see Tools/myrtos_trace.py)
+//
+// inversion : Priority inversion of Src/main.c (task_1 .. task_4, Mutex1 with priority inheritance)
+// deadlock  : Deadlock prevention of Src/main.c (task_5, task_6, Mutex1 and Mutex2)
+// periodic  : Three periodic tasks (rate monotonic priorities), shows the response time jitter of preemption
+// activate  : MYRTOS_Activate_Task of a task sleeping, waiting for a pool block and for a mutex, the idle task
+//             refused by MYRTOS_Terminate_Task
+// delete    : MYRTOS_Delete_Task of a sleeping task and of a mutex owner, calls on a deleted task, stack reuse
+// pool      : Memory pool emptied by a task, a timeout, a block freed by an interrupt to a waiting task,
+//             invalid blocks refused
+// fifo      : Batches through a FIFO of 8 elements, a producer faster than its consumer fills it (partial batches)
+// ring      : UART interrupt pushing characters to a parser task through a lock-free ring (wake up, timeout, full)
+// queue     : Message queue of 2 filled by two senders and an interrupt, emptied by a slower receiver
+// mail      : Frames of a camera broadcast without copies to a fast and a slow consumer (references, full mailbox)
+// semaphore : Two DMA channels shared by four tasks (waiters served by priority), a button interrupt giving a
+//             binary semaphore to its handler task (pending give, overflow, timeout)
+// handoff   : Three tasks waiting for a mutex, handed over by priority on each release, releases refused to
+//             an interrupt and to a task not owning it
+// chain     : Transitive priority inheritance along task_a -> Mutex1 / task_b -> Mutex2 / task_c, a cycle refused
+// requeue   : A mutex owner waiting for a semaphore, boosted ahead of the other waiter of the semaphore
+// ceiling   : A mutex with the priority ceiling protocol, its owner raised at once, its users never blocked on it
+//
+// The loops of Src/main.c do one step of work per iteration, here each step is SIM_STEP_US of virtual time
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Schedular.h"
+#include "My_RTOS_MemPool.h"
+#include "My_RTOS_FIFO.h"
+#include "My_RTOS_Ring.h"
+#include "My_RTOS_Queue.h"
+#include "My_RTOS_Mail.h"
+#include "My_RTOS_Semaphore.h"
+#include "My_RTOS_Trace.h"
+#include "Sim.h"
+
+
+#define SIM_STEP_US					10      // One loop iteration of the tasks in Src/main.c
+
+
+typedef struct{
+	const char* Name;
+	void (*P_Setup)(void);
+	uint32_t DurationTicks;
+}Sim_Scenario_t;
+
+
+Task_Config Task1, Task2, Task3, Task4, Task5, Task6;
+
+Mutex_Config Mutex1, Mutex2;
+
+uint8_t payload[3] = {1,2,3};
+
+// The idle task of the kernel (Schedular.c)
+extern Task_Config MYRTOS_IdleTask;
+
+
+
+// Results of the kernel calls in the logs
+const char* Sim_ErrorName(MYRTOS_errorID ErrorState)
+{
+	switch(ErrorState)
+	{
+	case NO_ERROR:                return "NO_ERROR";
+	case Task_Is_Idle:            return "Task_Is_Idle";
+	case Task_Not_Created:        return "Task_Not_Created";
+	case Task_Cant_Be_Deleted:    return "Task_Cant_Be_Deleted";
+	case Task_Owns_Mutex:         return "Task_Owns_Mutex";
+	case Mutex_Prevent_Deadlock:  return "Mutex_Prevent_Deadlock";
+	case Mutex_Ceiling_Violation: return "Mutex_Ceiling_Violation";
+	case Mutex_Unavailable:       return "Mutex_Unavailable";
+	case Wait_Cancelled:          return "Wait_Cancelled";
+	case Pool_Invalid_Config:     return "Pool_Invalid_Config";
+	case Pool_Invalid_Block:      return "Pool_Invalid_Block";
+	case Timeout_Expired:         return "Timeout_Expired";
+	case Ring_Invalid_Config:     return "Ring_Invalid_Config";
+	case Ring_Full:               return "Ring_Full";
+	case Ring_Empty:              return "Ring_Empty";
+	case Queue_Invalid_Config:    return "Queue_Invalid_Config";
+	case Queue_Full:              return "Queue_Full";
+	case Queue_Empty:             return "Queue_Empty";
+	case Mail_Invalid_Release:    return "Mail_Invalid_Release";
+	case Semaphore_Invalid_Config: return "Semaphore_Invalid_Config";
+	case Semaphore_Unavailable:   return "Semaphore_Unavailable";
+	case Semaphore_Overflow:      return "Semaphore_Overflow";
+	default:                      return "other error";
+	}
+}
+
+
+void Sim_Create(Task_Config* taskReference, void (*P_TaskEntry)(void), uint8_t Priority, const char* Name)
+{
+	taskReference->Stack_Size = 1024;
+	taskReference->P_TaskEntry = P_TaskEntry;
+	taskReference->Priority = Priority;
+	strcpy(taskReference->TaskName, Name);
+
+	if(MYRTOS_Create_Task(taskReference) != NO_ERROR)
+	{
+		fprintf(stderr, "MyRTOS sim: can't create %s\n", Name);
+		exit(EXIT_FAILURE);
+	}
+}
+
+
+
+// Priority inversion (Src/main.c)
+// Task1 acquires the mutex then activates task2, task2 activates task3, task3 activates task4,
+// task4 asks for the mutex, so task1 inherits its priority till releasing it
+
+void inversion_task1()
+{
+	static int counter1 = 0;
+	while(1){
+		Sim_Work(SIM_STEP_US);
+		counter1++;
+		if(counter1 == 100){
+			MYRTOS_AcquireMutex(&Mutex1, &Task1);
+			MYRTOS_Activate_Task(&Task2);
+		}
+		if(counter1 == 200)
+		{
+			counter1 = 0;
+			MYRTOS_ReleaseMutex(&Mutex1);
+		}
+	}
+}
+
+void inversion_task2()
+{
+	static int counter1 = 0;
+	while(1){
+		Sim_Work(SIM_STEP_US);
+		counter1++;
+		if(counter1 == 100){
+			MYRTOS_Activate_Task(&Task3);
+		}
+		if(counter1 == 200)
+		{
+			MYRTOS_Terminate_Task(&Task2);
+			counter1 = 0;
+		}
+	}
+}
+
+void inversion_task3()
+{
+	static int counter1 = 0;
+	while(1){
+		Sim_Work(SIM_STEP_US);
+		counter1++;
+		if(counter1 == 100){
+			MYRTOS_Activate_Task(&Task4);
+		}
+		if(counter1 == 200)
+		{
+			MYRTOS_Terminate_Task(&Task3);
+			counter1 = 0;
+		}
+	}
+}
+
+void inversion_task4()
+{
+	static int counter1 = 0;
+	while(1){
+		Sim_Work(SIM_STEP_US);
+		counter1++;
+		if(counter1 == 3)
+		{
+			MYRTOS_AcquireMutex(&Mutex1, &Task4);
+		}
+		if(counter1 == 100){
+			MYRTOS_ReleaseMutex(&Mutex1);
+			MYRTOS_Terminate_Task(&Task4);
+			counter1 = 0;
+		}
+	}
+}
+
+void inversion_Setup()
+{
+	strcpy(Mutex1.MutexName,"Mutex T1,T4");
+	Mutex1.Payload_Size = 3;
+	Mutex1.P_Payload = payload;
+
+	Sim_Create(&Task1, inversion_task1, 4, "task_1");
+	Sim_Create(&Task2, inversion_task2, 3, "task_2");
+	Sim_Create(&Task3, inversion_task3, 2, "task_3");
+	Sim_Create(&Task4, inversion_task4, 1, "task_4");
+
+	MYRTOS_Activate_Task(&Task1);
+}
+
+
+
+// Deadlock (Src/main.c)
+// task6 waits for Mutex1 while holding Mutex2, task5 asking for Mutex2 while holding Mutex1 is refused (a cycle)
+
+void deadlock_task5()
+{
+	static int counter1 = 0;
+	while(1){
+		Sim_Work(SIM_STEP_US);
+		counter1++;
+		if(counter1 == 100){
+			MYRTOS_AcquireMutex(&Mutex1, &Task5);
+			MYRTOS_Activate_Task(&Task6);
+			MYRTOS_AcquireMutex(&Mutex2, &Task5);
+		}
+		if(counter1 == 200)
+		{
+			MYRTOS_ReleaseMutex(&Mutex1);
+		}
+		if(counter1 == 300){
+			MYRTOS_ReleaseMutex(&Mutex2);
+			counter1 = 0;
+		}
+	}
+}
+
+void deadlock_task6()
+{
+	static int counter1 = 0;
+	MYRTOS_AcquireMutex(&Mutex2, &Task6);
+	while(1){
+		Sim_Work(SIM_STEP_US);
+		counter1++;
+		if(counter1 == 3)
+		{
+			MYRTOS_AcquireMutex(&Mutex1, &Task6);
+		}
+		if(counter1 == 100){
+			MYRTOS_ReleaseMutex(&Mutex1);
+			MYRTOS_ReleaseMutex(&Mutex2);
+			MYRTOS_Terminate_Task(&Task6);
+		}
+		if(counter1 == 400)
+		{
+			MYRTOS_ReleaseMutex(&Mutex2);
+			counter1 = 0;
+		}
+	}
+}
+
+void deadlock_Setup()
+{
+	strcpy(Mutex1.MutexName,"Mutex T1,T4");
+	Mutex1.Payload_Size = 3;
+	Mutex1.P_Payload = payload;
+
+	Sim_Create(&Task5, deadlock_task5, 4, "task_5");
+	Sim_Create(&Task6, deadlock_task6, 2, "task_6");
+
+	MYRTOS_Activate_Task(&Task5);
+}
+
+
+
+// Periodic tasks: period (ticks) / work (us) / priority
+// task_fast: 5 / 1000 / 1, task_mid: 10 / 2500 / 2, task_slow: 20 / 4000 / 3
+
+void periodic_Job(Task_Config* taskReference, uint32_t PeriodTicks, uint32_t WorkUs)
+{
+	while(1){
+		Sim_Work(WorkUs);
+		MYRTOS_Task_Wait(PeriodTicks, taskReference);
+	}
+}
+
+void periodic_fast()
+{
+	periodic_Job(&Task1, 5, 1000);
+}
+
+void periodic_mid()
+{
+	periodic_Job(&Task2, 10, 2500);
+}
+
+void periodic_slow()
+{
+	periodic_Job(&Task3, 20, 4000);
+}
+
+void periodic_Setup()
+{
+	Sim_Create(&Task1, periodic_fast, 1, "task_fast");
+	Sim_Create(&Task2, periodic_mid, 2, "task_mid");
+	Sim_Create(&Task3, periodic_slow, 3, "task_slow");
+
+	MYRTOS_Activate_Task(&Task1);
+	MYRTOS_Activate_Task(&Task2);
+	MYRTOS_Activate_Task(&Task3);
+}
+
+
+
+// Early activation
+// task_b activates task_a in the middle of its sleep of 10 ticks: the sleep ends at once, and the next
+// ones last their whole time (task_a left the waiting list, its next wait doesn't link it twice).
+// Then task_a waits for the only block of a pool, task_b holds it: the activation ends that wait too
+// (NULL, as a timeout), and the block freed later goes to the next wait. The same for a mutex task_b owns:
+// the wait ends with Wait_Cancelled and task_b loses the priority it inherited from task_a. The idle task
+// can't be terminated (no task would be ready)
+
+Task_Config Activate_A, Activate_B;
+
+MYRTOS_Pool_t Activate_Pool;
+MYRTOS_POOL_STORAGE(Activate_PoolStorage, 16, 1);
+
+Mutex_Config Activate_Mutex;
+
+void activate_task_a()
+{
+	void* P_Block;
+	MYRTOS_errorID ErrorState;
+
+	while(1){
+		Sim_Work(500);
+		MYRTOS_Task_Wait(10, &Activate_A);
+		Sim_Log("task_a woke");
+
+		P_Block = MYRTOS_Pool_Alloc(&Activate_Pool, MYRTOS_WAIT_FOREVER);
+		Sim_Log("task_a block: %s", (P_Block != NULL) ? "taken" : "NULL");
+		if(P_Block != NULL)
+			MYRTOS_Pool_Free(&Activate_Pool, P_Block);
+
+		ErrorState = MYRTOS_AcquireMutex(&Activate_Mutex, &Activate_A);
+		Sim_Log("task_a mutex: %s", Sim_ErrorName(ErrorState));
+		if(ErrorState == NO_ERROR)
+			MYRTOS_ReleaseMutex(&Activate_Mutex);
+	}
+}
+
+void activate_task_b()
+{
+	void* P_Block = MYRTOS_Pool_Alloc(&Activate_Pool, MYRTOS_NO_WAIT);
+
+	MYRTOS_AcquireMutex(&Activate_Mutex, &Activate_B);
+
+	MYRTOS_Task_Wait(4, &Activate_B);
+	Sim_Log("task_b activates task_a (sleeping)");
+	MYRTOS_Activate_Task(&Activate_A);
+
+	MYRTOS_Task_Wait(2, &Activate_B);
+	Sim_Log("task_b activates task_a (waiting for a block)");
+	MYRTOS_Activate_Task(&Activate_A);
+	Sim_Log("task_b priority %u", Activate_B.Priority);
+
+	MYRTOS_Task_Wait(1, &Activate_B);
+	Sim_Log("task_b activates task_a (waiting for the mutex)");
+	MYRTOS_Activate_Task(&Activate_A);
+	Sim_Log("task_b priority %u", Activate_B.Priority);
+
+	MYRTOS_Task_Wait(13, &Activate_B);
+	Sim_Log("task_b frees its block");
+	MYRTOS_Pool_Free(&Activate_Pool, P_Block);
+	Sim_Log("task_b releases the mutex");
+	MYRTOS_ReleaseMutex(&Activate_Mutex);
+
+	Sim_Log("task_b terminates the idle task: %s", Sim_ErrorName(MYRTOS_Terminate_Task(&MYRTOS_IdleTask)));
+	MYRTOS_Terminate_Task(&Activate_B);
+}
+
+void activate_Setup()
+{
+	MYRTOS_Pool_Init(&Activate_Pool, Activate_PoolStorage, 16, 1);
+
+	Sim_Create(&Activate_A, activate_task_a, 1, "task_a");
+	Sim_Create(&Activate_B, activate_task_b, 3, "task_b");
+
+	MYRTOS_Activate_Task(&Activate_A);
+	MYRTOS_Activate_Task(&Activate_B);
+}
+
+
+
+// Task deletion
+// The manager creates the worker while the OS runs and deletes it in the middle of a sleep, then every
+// call on the deleted worker is refused. The worker is created again on the freed stack, takes a mutex
+// and can't be deleted till it releases it. At the end the manager deletes itself.
+// The kernel counts the run time of the worker since it was created again (Kernel(%) < CPU(%))
+
+Task_Config Delete_Manager, Delete_Worker;
+
+Mutex_Config Delete_Mutex;
+
+uint32_t Delete_WorkerRuns;
+
+void delete_worker()
+{
+	Delete_WorkerRuns++;
+	Sim_Log("worker run %u starts", Delete_WorkerRuns);
+
+	if(Delete_WorkerRuns == 2)
+	{
+		MYRTOS_AcquireMutex(&Delete_Mutex, &Delete_Worker);
+		MYRTOS_Task_Wait(3, &Delete_Worker);
+		MYRTOS_ReleaseMutex(&Delete_Mutex);
+		Sim_Log("worker released the mutex");
+	}
+
+	while(1){
+		Sim_Work(300);
+		MYRTOS_Task_Wait(2, &Delete_Worker);
+	}
+}
+
+void delete_manager()
+{
+	uint32_t FirstStack;
+	MYRTOS_errorID ErrorState;
+
+	Sim_Create(&Delete_Worker, delete_worker, 1, "worker");
+	FirstStack = Delete_Worker._S_PSP_Task;
+	MYRTOS_Activate_Task(&Delete_Worker);
+
+	MYRTOS_Task_Wait(3, &Delete_Manager);
+	ErrorState = MYRTOS_Delete_Task(&Delete_Worker);
+	Sim_Log("delete the sleeping worker: %s", Sim_ErrorName(ErrorState));
+	ErrorState = MYRTOS_Activate_Task(&Delete_Worker);
+	Sim_Log("activate it: %s", Sim_ErrorName(ErrorState));
+	ErrorState = MYRTOS_Terminate_Task(&Delete_Worker);
+	Sim_Log("terminate it: %s", Sim_ErrorName(ErrorState));
+	ErrorState = MYRTOS_Task_Wait(1, &Delete_Worker);
+	Sim_Log("make it wait: %s", Sim_ErrorName(ErrorState));
+	ErrorState = MYRTOS_Delete_Task(&Delete_Worker);
+	Sim_Log("delete it again: %s", Sim_ErrorName(ErrorState));
+	ErrorState = MYRTOS_Delete_Task(&MYRTOS_IdleTask);
+	Sim_Log("delete the idle task: %s", Sim_ErrorName(ErrorState));
+
+	// No tick passed: the worker didn't wake up in its old sleep
+	MYRTOS_Task_Wait(4, &Delete_Manager);
+
+	Sim_Create(&Delete_Worker, delete_worker, 1, "worker");
+	Sim_Log("worker created again, on its freed stack: %s", (Delete_Worker._S_PSP_Task == FirstStack) ? "yes" : "no");
+	MYRTOS_Activate_Task(&Delete_Worker);
+
+	ErrorState = MYRTOS_Delete_Task(&Delete_Worker);
+	Sim_Log("delete the mutex owner: %s", Sim_ErrorName(ErrorState));
+
+	MYRTOS_Task_Wait(5, &Delete_Manager);
+	ErrorState = MYRTOS_Delete_Task(&Delete_Worker);
+	Sim_Log("delete the worker after its release: %s", Sim_ErrorName(ErrorState));
+
+	Sim_Log("manager deletes itself");
+	MYRTOS_Delete_Task(&Delete_Manager);
+}
+
+void delete_Setup()
+{
+	Sim_Create(&Delete_Manager, delete_manager, 2, "manager");
+
+	MYRTOS_Activate_Task(&Delete_Manager);
+}
+
+
+
+// Memory pool
+// The logger takes both blocks of the pool for a DMA transfer, and its frees of addresses that aren't blocks
+// of the pool are refused. The sender finds the pool empty: its first wait times out after one tick, then it
+// waits forever. The DMA interrupt (in the middle of a tick) can't wait for a block, it frees one, which goes
+// straight to the sender: the sender runs as soon as the interrupt returns
+
+#define POOL_DMA_IRQn				11      // DMA1_Channel1 of the STM32F103
+
+Task_Config Pool_Sender, Pool_Logger;
+
+MYRTOS_Pool_t Pool_Packets;
+MYRTOS_POOL_STORAGE(Pool_PacketsStorage, 30, 2);
+
+void* Pool_DmaBlocks[2];
+
+void pool_dma_done()
+{
+	MYRTOS_TRACE_ISR_ENTER();
+
+	Sim_Log("DMA interrupt, alloc without waiting: %s",
+			(MYRTOS_Pool_Alloc(&Pool_Packets, MYRTOS_WAIT_FOREVER) != NULL) ? "block" : "NULL");
+	Sim_Log("DMA interrupt frees the first block: %s", Sim_ErrorName(MYRTOS_Pool_Free(&Pool_Packets, Pool_DmaBlocks[0])));
+
+	MYRTOS_TRACE_ISR_EXIT();
+}
+
+void pool_sender()
+{
+	void* P_Block;
+
+	MYRTOS_Task_Wait(1, &Pool_Sender);
+
+	P_Block = MYRTOS_Pool_Alloc(&Pool_Packets, 1);
+	Sim_Log("sender alloc, 1 tick timeout: %s", (P_Block != NULL) ? "block" : "NULL");
+
+	P_Block = MYRTOS_Pool_Alloc(&Pool_Packets, MYRTOS_WAIT_FOREVER);
+	Sim_Log("sender got %s", (P_Block == Pool_DmaBlocks[0]) ? "the block freed by the interrupt" : "another block");
+
+	Sim_Work(400);
+	MYRTOS_Pool_Free(&Pool_Packets, P_Block);
+	Sim_Log("sender sent it, %u free", MYRTOS_Pool_Get_FreeBlocks(&Pool_Packets));
+	MYRTOS_Terminate_Task(&Pool_Sender);
+}
+
+void pool_logger()
+{
+	uint8_t Other[8];
+
+	Pool_DmaBlocks[0] = MYRTOS_Pool_Alloc(&Pool_Packets, MYRTOS_NO_WAIT);
+	Pool_DmaBlocks[1] = MYRTOS_Pool_Alloc(&Pool_Packets, MYRTOS_NO_WAIT);
+	Sim_Log("logger took 2 blocks of %u bytes, %u free", Pool_Packets.BlockSize, MYRTOS_Pool_Get_FreeBlocks(&Pool_Packets));
+
+	Sim_Log("logger frees an address inside a block: %s",
+			Sim_ErrorName(MYRTOS_Pool_Free(&Pool_Packets, (uint8_t*)Pool_DmaBlocks[1] + 4)));
+	Sim_Log("logger frees a buffer of its own: %s", Sim_ErrorName(MYRTOS_Pool_Free(&Pool_Packets, Other)));
+
+	// Logs while the DMA runs
+	Sim_Work(4000);
+
+	MYRTOS_Pool_Free(&Pool_Packets, Pool_DmaBlocks[1]);
+	Sim_Log("logger done, %u free (%u at least)", MYRTOS_Pool_Get_FreeBlocks(&Pool_Packets), Pool_Packets.MinFreeBlocksNum);
+	MYRTOS_Terminate_Task(&Pool_Logger);
+}
+
+void pool_Setup()
+{
+	Sim_Log("pool without storage: %s", Sim_ErrorName(MYRTOS_Pool_Init(&Pool_Packets, NULL, 30, 2)));
+	MYRTOS_Pool_Init(&Pool_Packets, Pool_PacketsStorage, 30, 2);
+
+	Sim_Create(&Pool_Sender, pool_sender, 1, "sender");
+	Sim_Create(&Pool_Logger, pool_logger, 3, "logger");
+
+	MYRTOS_Activate_Task(&Pool_Sender);
+	MYRTOS_Activate_Task(&Pool_Logger);
+
+	Sim_Raise_IRQ(3500, POOL_DMA_IRQn, pool_dma_done);
+}
+
+
+
+// FIFO batches
+// The producer puts a batch of 5 samples every 2 ticks, the consumer takes up to 4 every 3 ticks: the FIFO of 8
+// fills, the batches are cut to the free places (none when full), then both run at the consumer's pace.
+// Head and tail pass the end of the buffer, the samples stay in order. The producer stops after 8 batches
+// and the consumer empties the FIFO
+
+#define FIFO_PRODUCER_BATCHES		8
+
+Task_Config Fifo_Producer, Fifo_Consumer;
+
+FIFO_Buffer_t Fifo_Samples;
+FIFO_BUFFER(Fifo_SamplesBuffer, uint16_t, 8);
+
+uint8_t Fifo_ProducerDone;
+
+void fifo_producer()
+{
+	uint16_t Batch[5], Next = 0;
+	uint32_t i, Rounds, Accepted;
+
+	for(Rounds=0 ; Rounds<FIFO_PRODUCER_BATCHES ; Rounds++)
+	{
+		for(i=0 ; i<5 ; i++)
+			Batch[i] = Next + i;
+
+		Accepted = FIFO_Enqeue_Batch(&Fifo_Samples, Batch, 5);
+		Next += Accepted;
+		Sim_Log("producer put %u of 5, count %u", Accepted, FIFO_Count(&Fifo_Samples));
+		if(Accepted == 0)
+			Sim_Log("producer single put: %s", (FIFO_Enqeue(&Fifo_Samples, &Next) == FIFO_Full) ? "FIFO_Full" : "stored");
+
+		Sim_Work(200);
+		MYRTOS_Task_Wait(2, &Fifo_Producer);
+	}
+
+	Fifo_ProducerDone = 1;
+	MYRTOS_Terminate_Task(&Fifo_Producer);
+}
+
+void fifo_consumer()
+{
+	uint16_t Batch[4];
+	uint32_t Taken;
+
+	do{
+		Taken = FIFO_Deqeue_Batch(&Fifo_Samples, Batch, 4);
+		if(Taken == 0)
+			Sim_Log("consumer took 0, count %u", FIFO_Count(&Fifo_Samples));
+		else
+			Sim_Log("consumer took %u (%u..%u), count %u", Taken, Batch[0], Batch[Taken - 1], FIFO_Count(&Fifo_Samples));
+
+		Sim_Work(300);
+		MYRTOS_Task_Wait(3, &Fifo_Consumer);
+	}while((Taken != 0) || !Fifo_ProducerDone);
+
+	MYRTOS_Terminate_Task(&Fifo_Consumer);
+}
+
+void fifo_Setup()
+{
+	Sim_Log("FIFO of 6 elements: %s",
+			(FIFO_Init(&Fifo_Samples, Fifo_SamplesBuffer, sizeof(uint16_t), 6) == FIFO_Invalid_Length) ? "FIFO_Invalid_Length" : "created");
+	FIFO_Init(&Fifo_Samples, Fifo_SamplesBuffer, sizeof(uint16_t), 8);
+
+	Sim_Create(&Fifo_Consumer, fifo_consumer, 1, "consumer");
+	Sim_Create(&Fifo_Producer, fifo_producer, 2, "producer");
+
+	MYRTOS_Activate_Task(&Fifo_Consumer);
+	MYRTOS_Activate_Task(&Fifo_Producer);
+}
+
+
+
+// Lock-free ring
+// The UART interrupt pushes a character every 100 us, the parser sleeps in MYRTOS_Ring_Pop (3 ticks timeout).
+// The first push wakes it and it keeps up with the line without sleeping, then its wait times out. The second
+// line comes while a higher priority task runs: the ring of 4 fills and the interrupt loses the last characters
+
+#define RING_UART_IRQn				37      // USART1 of the STM32F103
+
+Task_Config Ring_Parser, Ring_Busy;
+
+MYRTOS_Ring_t Ring_Rx;
+FIFO_BUFFER(Ring_RxBuffer, char, 4);
+
+const char* Ring_Line;                // Line being received by the interrupt
+uint32_t Ring_Received;
+
+void ring_uart_rx()
+{
+	char Received = Ring_Line[Ring_Received++];
+
+	MYRTOS_TRACE_ISR_ENTER();
+
+	if(MYRTOS_Ring_Push(&Ring_Rx, &Received) == Ring_Full)
+		Sim_Log("UART interrupt: ring full, '%c' lost", Received);
+
+	// Next character
+	if(Ring_Line[Ring_Received] != '\0')
+		Sim_Raise_IRQ(Sim_Get_Time() + 100, RING_UART_IRQn, ring_uart_rx);
+
+	MYRTOS_TRACE_ISR_EXIT();
+}
+
+void ring_Receive_Line(uint32_t TimeUs, const char* Line)
+{
+	Ring_Line = Line;
+	Ring_Received = 0;
+	Sim_Raise_IRQ(TimeUs, RING_UART_IRQn, ring_uart_rx);
+}
+
+void ring_parser()
+{
+	char Received;
+	MYRTOS_errorID ErrorState;
+
+	ErrorState = MYRTOS_Ring_Pop(&Ring_Rx, &Received, MYRTOS_NO_WAIT);
+	Sim_Log("parser pops without waiting: %s", Sim_ErrorName(ErrorState));
+
+	while(1){
+		ErrorState = MYRTOS_Ring_Pop(&Ring_Rx, &Received, 3);
+
+		if(ErrorState == NO_ERROR)
+		{
+			Sim_Log("parser got '%c'", Received);
+			Sim_Work(150);
+		}else{
+			Sim_Log("parser: %s", Sim_ErrorName(ErrorState));
+		}
+	}
+}
+
+void ring_busy()
+{
+	MYRTOS_Task_Wait(4, &Ring_Busy);
+
+	ring_Receive_Line(Sim_Get_Time() + 100, "ABCDEF");
+	Sim_Work(1000);
+
+	MYRTOS_Terminate_Task(&Ring_Busy);
+}
+
+void ring_Setup()
+{
+	Sim_Log("ring of 3 elements: %s", Sim_ErrorName(MYRTOS_Ring_Init(&Ring_Rx, Ring_RxBuffer, sizeof(char), 3)));
+	MYRTOS_Ring_Init(&Ring_Rx, Ring_RxBuffer, sizeof(char), 4);
+
+	Sim_Create(&Ring_Busy, ring_busy, 1, "busy");
+	Sim_Create(&Ring_Parser, ring_parser, 2, "parser");
+
+	MYRTOS_Activate_Task(&Ring_Busy);
+	MYRTOS_Activate_Task(&Ring_Parser);
+
+	ring_Receive_Line(1500, "Hi!");
+}
+
+
+
+// Message queue
+// The sensor sends two rounds of 3 readings 5 ticks apart to a queue of 2, each send waits 1 tick at most for
+// a place. The logger (the lowest priority) takes one every 1800 us: the place it frees goes to the first waiting
+// sender (the sensor before the control task). In the second round the sensor's third send times out while it
+// waits for a place, and the ADC interrupt can't wait (Queue_Full). Once the queue is empty, the interrupt's
+// reading is copied straight to the waiting logger, whose next wait times out
+
+#define QUEUE_ADC_IRQn				18      // ADC1_2 of the STM32F103
+
+typedef struct{
+	char Source;                      // 's': sensor, 'c': control, 'a': ADC interrupt
+	uint16_t Value;
+}Queue_Reading_t;
+
+Task_Config Queue_Sensor, Queue_Control, Queue_Logger;
+
+MYRTOS_Queue_t Queue_Readings;
+MYRTOS_QUEUE_STORAGE(Queue_ReadingsStorage, sizeof(Queue_Reading_t), 2);
+
+void queue_adc_done()
+{
+	Queue_Reading_t Reading = {'a', 500};
+	MYRTOS_errorID ErrorState;
+
+	MYRTOS_TRACE_ISR_ENTER();
+
+	ErrorState = MYRTOS_Queue_Send(&Queue_Readings, &Reading, MYRTOS_WAIT_FOREVER);
+	Sim_Log("ADC interrupt sends a500: %s", Sim_ErrorName(ErrorState));
+
+	MYRTOS_TRACE_ISR_EXIT();
+}
+
+void queue_sensor()
+{
+	Queue_Reading_t Reading = {'s', 0};
+	uint32_t i;
+
+	while(Reading.Value < 6){
+		for(i=0 ; i<3 ; i++)
+		{
+			Reading.Value++;
+			Sim_Log("sensor sends s%u: %s", Reading.Value, Sim_ErrorName(MYRTOS_Queue_Send(&Queue_Readings, &Reading, 1)));
+		}
+
+		MYRTOS_Task_Wait(5, &Queue_Sensor);
+	}
+
+	MYRTOS_Terminate_Task(&Queue_Sensor);
+}
+
+void queue_control()
+{
+	Queue_Reading_t Reading = {'c', 100};
+
+	Sim_Log("control sends c100: %s", Sim_ErrorName(MYRTOS_Queue_Send(&Queue_Readings, &Reading, MYRTOS_WAIT_FOREVER)));
+	MYRTOS_Terminate_Task(&Queue_Control);
+}
+
+void queue_logger()
+{
+	Queue_Reading_t Reading;
+	MYRTOS_errorID ErrorState;
+
+	while(1){
+		ErrorState = MYRTOS_Queue_Receive(&Queue_Readings, &Reading, 4);
+
+		if(ErrorState == NO_ERROR)
+		{
+			Sim_Log("logger got %c%u, %u queued", Reading.Source, Reading.Value, MYRTOS_Queue_Count(&Queue_Readings));
+			Sim_Work(1800);
+		}else{
+			Sim_Log("logger: %s", Sim_ErrorName(ErrorState));
+		}
+	}
+}
+
+void queue_Setup()
+{
+	Sim_Log("queue of 3 readings: %s",
+			Sim_ErrorName(MYRTOS_Queue_Init(&Queue_Readings, Queue_ReadingsStorage, sizeof(Queue_Reading_t), 3)));
+	MYRTOS_Queue_Init(&Queue_Readings, Queue_ReadingsStorage, sizeof(Queue_Reading_t), 2);
+
+	Sim_Create(&Queue_Sensor, queue_sensor, 1, "sensor");
+	Sim_Create(&Queue_Control, queue_control, 2, "control");
+	Sim_Create(&Queue_Logger, queue_logger, 3, "logger");
+
+	MYRTOS_Activate_Task(&Queue_Sensor);
+	MYRTOS_Activate_Task(&Queue_Control);
+	MYRTOS_Activate_Task(&Queue_Logger);
+
+	Sim_Raise_IRQ(6500, QUEUE_ADC_IRQn, queue_adc_done);
+	Sim_Raise_IRQ(12500, QUEUE_ADC_IRQn, queue_adc_done);
+}
+
+
+
+// Zero-copy mails
+// The camera takes a frame from a pool of 4 every 2 ticks (1 tick at most) and broadcasts it to the display
+// and to the storage. The display is fast, the storage is slow: its frames keep their blocks and its mailbox
+// of 2 fills, the broadcast then returns Queue_Full and the reference of the storage is released at once.
+// A block goes back to the pool with its last release, a second release of the same frame is refused
+
+typedef struct{
+	uint32_t Number;
+	uint8_t Pixels[12];
+}Mail_Frame_t;
+
+Task_Config Mail_Camera, Mail_Display, Mail_Storage;
+
+MYRTOS_Pool_t Mail_Frames;
+MYRTOS_MAIL_POOL_STORAGE(Mail_FramesStorage, sizeof(Mail_Frame_t), 4);
+
+MYRTOS_Mailbox_t Mail_ToDisplay, Mail_ToStorage;
+MYRTOS_MAILBOX_STORAGE(Mail_ToDisplayStorage, 2);
+MYRTOS_MAILBOX_STORAGE(Mail_ToStorageStorage, 2);
+
+MYRTOS_Mailbox_t* const Mail_Consumers[2] = {&Mail_ToDisplay, &Mail_ToStorage};
+
+void mail_camera()
+{
+	Mail_Frame_t* P_Frame;
+	uint32_t Number = 0;
+	MYRTOS_errorID ErrorState;
+
+	while(1){
+		P_Frame = MYRTOS_Mail_Alloc(&Mail_Frames, 1);
+
+		if(P_Frame == NULL)
+		{
+			Sim_Log("camera: no free frame");
+		}else{
+			P_Frame->Number = ++Number;
+			ErrorState = MYRTOS_Mail_Broadcast(Mail_Consumers, 2, P_Frame, MYRTOS_NO_WAIT);
+			Sim_Log("camera broadcasts frame %u: %s, %u free", Number, Sim_ErrorName(ErrorState), MYRTOS_Pool_Get_FreeBlocks(&Mail_Frames));
+		}
+
+		MYRTOS_Task_Wait(2, &Mail_Camera);
+	}
+}
+
+void mail_display()
+{
+	Mail_Frame_t* P_Frame;
+
+	while(1){
+		MYRTOS_Mail_Fetch(&Mail_ToDisplay, (void**)&P_Frame, MYRTOS_WAIT_FOREVER);
+		Sim_Work(300);
+		MYRTOS_Mail_Release(P_Frame);
+		Sim_Log("display showed frame %u", P_Frame->Number);
+	}
+}
+
+void mail_storage()
+{
+	Mail_Frame_t* P_Frame;
+	uint8_t First = 1;
+
+	while(1){
+		MYRTOS_Mail_Fetch(&Mail_ToStorage, (void**)&P_Frame, MYRTOS_WAIT_FOREVER);
+		Sim_Work(4500);
+		MYRTOS_Mail_Release(P_Frame);
+		Sim_Log("storage wrote frame %u, %u free", P_Frame->Number, MYRTOS_Pool_Get_FreeBlocks(&Mail_Frames));
+
+		if(First)
+		{
+			Sim_Log("storage releases it again: %s", Sim_ErrorName(MYRTOS_Mail_Release(P_Frame)));
+			First = 0;
+		}
+	}
+}
+
+void mail_Setup()
+{
+	MYRTOS_Pool_Init(&Mail_Frames, Mail_FramesStorage, MYRTOS_MAIL_BLOCK_SIZE(sizeof(Mail_Frame_t)), 4);
+	MYRTOS_Mailbox_Init(&Mail_ToDisplay, Mail_ToDisplayStorage, 2);
+	MYRTOS_Mailbox_Init(&Mail_ToStorage, Mail_ToStorageStorage, 2);
+
+	Sim_Create(&Mail_Display, mail_display, 2, "display");
+	Sim_Create(&Mail_Storage, mail_storage, 3, "storage");
+	Sim_Create(&Mail_Camera, mail_camera, 1, "camera");
+
+	MYRTOS_Activate_Task(&Mail_Display);
+	MYRTOS_Activate_Task(&Mail_Storage);
+	MYRTOS_Activate_Task(&Mail_Camera);
+}
+
+
+
+// Semaphores
+// copy_a and copy_b take the two DMA channels (counting semaphore) and hold them 4 and 5 ticks. log_c (the
+// lowest priority) finds none, then waits for one before copy_d: the first channel given goes to copy_d.
+// The button interrupt gives a binary semaphore to its handler: the first press wakes it, the second one
+// (while it works) stays pending and the third one overflows. The handler then times out waiting
+
+#define SEMAPHORE_BUTTON_IRQn		6       // EXTI0 of the STM32F103
+
+Task_Config Semaphore_CopyA, Semaphore_CopyB, Semaphore_LogC, Semaphore_CopyD, Semaphore_Button;
+
+MYRTOS_Semaphore_t Semaphore_Channels, Semaphore_Pressed;
+
+void semaphore_Use_Channel(Task_Config* P_Task, uint32_t HoldTicks)
+{
+	MYRTOS_Semaphore_Take(&Semaphore_Channels, MYRTOS_WAIT_FOREVER);
+	Sim_Log("%s takes a channel, %u left", P_Task->TaskName, MYRTOS_Semaphore_Count(&Semaphore_Channels));
+
+	MYRTOS_Task_Wait(HoldTicks, P_Task);
+
+	MYRTOS_Semaphore_Give(&Semaphore_Channels);
+	Sim_Log("%s gives its channel", P_Task->TaskName);
+
+	MYRTOS_Terminate_Task(P_Task);
+}
+
+void semaphore_copy_a()
+{
+	semaphore_Use_Channel(&Semaphore_CopyA, 4);
+}
+
+void semaphore_copy_b()
+{
+	semaphore_Use_Channel(&Semaphore_CopyB, 5);
+}
+
+void semaphore_log_c()
+{
+	MYRTOS_Task_Wait(1, &Semaphore_LogC);
+	Sim_Log("log_c takes a channel without waiting: %s", Sim_ErrorName(MYRTOS_Semaphore_Take(&Semaphore_Channels, MYRTOS_NO_WAIT)));
+
+	semaphore_Use_Channel(&Semaphore_LogC, 2);
+}
+
+void semaphore_copy_d()
+{
+	MYRTOS_Task_Wait(2, &Semaphore_CopyD);
+
+	semaphore_Use_Channel(&Semaphore_CopyD, 2);
+}
+
+void semaphore_button_press()
+{
+	MYRTOS_TRACE_ISR_ENTER();
+
+	Sim_Log("button interrupt gives: %s", Sim_ErrorName(MYRTOS_Semaphore_Give(&Semaphore_Pressed)));
+
+	MYRTOS_TRACE_ISR_EXIT();
+}
+
+void semaphore_button()
+{
+	MYRTOS_errorID ErrorState;
+
+	while(1){
+		ErrorState = MYRTOS_Semaphore_Take(&Semaphore_Pressed, 5);
+		Sim_Log("button handler: %s", Sim_ErrorName(ErrorState));
+
+		if(ErrorState != NO_ERROR)
+			MYRTOS_Terminate_Task(&Semaphore_Button);
+
+		Sim_Work(400);
+	}
+}
+
+void semaphore_Setup()
+{
+	Sim_Log("semaphore of 3 counts at most 2: %s", Sim_ErrorName(MYRTOS_Semaphore_Init(&Semaphore_Channels, 3, 2)));
+	MYRTOS_Semaphore_Init(&Semaphore_Channels, 2, 2);
+	MYRTOS_Semaphore_Init(&Semaphore_Pressed, 0, 1);
+
+	Sim_Create(&Semaphore_Button, semaphore_button, 1, "button");
+	Sim_Create(&Semaphore_CopyD, semaphore_copy_d, 2, "copy_d");
+	Sim_Create(&Semaphore_CopyA, semaphore_copy_a, 3, "copy_a");
+	Sim_Create(&Semaphore_CopyB, semaphore_copy_b, 4, "copy_b");
+	Sim_Create(&Semaphore_LogC, semaphore_log_c, 5, "log_c");
+
+	MYRTOS_Activate_Task(&Semaphore_Button);
+	MYRTOS_Activate_Task(&Semaphore_CopyD);
+	MYRTOS_Activate_Task(&Semaphore_CopyA);
+	MYRTOS_Activate_Task(&Semaphore_CopyB);
+	MYRTOS_Activate_Task(&Semaphore_LogC);
+
+	Sim_Raise_IRQ(3500, SEMAPHORE_BUTTON_IRQn, semaphore_button_press);
+	Sim_Raise_IRQ(3700, SEMAPHORE_BUTTON_IRQn, semaphore_button_press);
+	Sim_Raise_IRQ(3800, SEMAPHORE_BUTTON_IRQn, semaphore_button_press);
+}
+
+
+
+// Mutex hand-off to several waiters
+// owner (priority 4) holds the mutex while task_a (3), task_c (2) and task_b (1) ask for it, in this order:
+// each one preempts the owner and raises it to its priority. The timer interrupt can neither release nor take
+// the mutex. Each release hands it directly to the highest priority waiter (task_b, task_c then task_a), which
+// owns it when it runs, and the old owner drops back to its priority. The owner's second release is refused
+
+#define HANDOFF_TIMER_IRQn			28      // TIM2 of the STM32F103
+
+Task_Config Handoff_Owner, Handoff_A, Handoff_B, Handoff_C;
+
+Mutex_Config Handoff_Mutex;
+
+void handoff_Waiter(Task_Config* P_Task)
+{
+	MYRTOS_errorID ErrorState;
+
+	ErrorState = MYRTOS_AcquireMutex(&Handoff_Mutex, P_Task);
+	Sim_Log("%s takes the mutex: %s, owner %s", P_Task->TaskName, Sim_ErrorName(ErrorState), Handoff_Mutex.currentTask->TaskName);
+	Sim_Work(500);
+
+	MYRTOS_ReleaseMutex(&Handoff_Mutex);
+	Sim_Log("%s released it, priority %u", P_Task->TaskName, P_Task->Priority);
+
+	MYRTOS_Terminate_Task(P_Task);
+}
+
+void handoff_task_a()
+{
+	handoff_Waiter(&Handoff_A);
+}
+
+void handoff_task_b()
+{
+	handoff_Waiter(&Handoff_B);
+}
+
+void handoff_task_c()
+{
+	handoff_Waiter(&Handoff_C);
+}
+
+void handoff_timer()
+{
+	MYRTOS_TRACE_ISR_ENTER();
+
+	Sim_Log("timer interrupt releases the mutex: %s", Sim_ErrorName(MYRTOS_ReleaseMutex(&Handoff_Mutex)));
+	Sim_Log("timer interrupt takes the mutex: %s", Sim_ErrorName(MYRTOS_AcquireMutex(&Handoff_Mutex, &Handoff_Owner)));
+
+	MYRTOS_TRACE_ISR_EXIT();
+}
+
+void handoff_owner()
+{
+	MYRTOS_AcquireMutex(&Handoff_Mutex, &Handoff_Owner);
+	Sim_Work(500);
+
+	MYRTOS_Activate_Task(&Handoff_A);
+	Sim_Log("owner priority %u", Handoff_Owner.Priority);
+	MYRTOS_Activate_Task(&Handoff_C);
+	Sim_Log("owner priority %u", Handoff_Owner.Priority);
+	MYRTOS_Activate_Task(&Handoff_B);
+	Sim_Log("owner priority %u", Handoff_Owner.Priority);
+
+	Sim_Work(1000);
+	MYRTOS_ReleaseMutex(&Handoff_Mutex);
+	Sim_Log("owner released it, priority %u", Handoff_Owner.Priority);
+
+	Sim_Log("owner releases it again: %s", Sim_ErrorName(MYRTOS_ReleaseMutex(&Handoff_Mutex)));
+
+	MYRTOS_Terminate_Task(&Handoff_Owner);
+}
+
+void handoff_Setup()
+{
+	strcpy(Handoff_Mutex.MutexName, "Mutex hand-off");
+
+	Sim_Create(&Handoff_B, handoff_task_b, 1, "task_b");
+	Sim_Create(&Handoff_C, handoff_task_c, 2, "task_c");
+	Sim_Create(&Handoff_A, handoff_task_a, 3, "task_a");
+	Sim_Create(&Handoff_Owner, handoff_owner, 4, "owner");
+
+	MYRTOS_Activate_Task(&Handoff_Owner);
+
+	Sim_Raise_IRQ(2000, HANDOFF_TIMER_IRQn, handoff_timer);
+}
+
+
+
+// Chain of owners
+// task_c (priority 5) owns Mutex2, task_b (3) owns Mutex1 and waits for Mutex2, then task_a (1) waits for
+// Mutex1: task_b and task_c both run at priority 1. task_c asking for Mutex1 would close a cycle (refused).
+// task_b gets Mutex2 and keeps priority 1 while task_a waits for its Mutex1, each release drops the boost
+
+Task_Config Chain_A, Chain_B, Chain_C;
+
+Mutex_Config Chain_Mutex1, Chain_Mutex2;
+
+void chain_task_a()
+{
+	MYRTOS_AcquireMutex(&Chain_Mutex1, &Chain_A);
+	Sim_Log("task_a owns Mutex1");
+	MYRTOS_ReleaseMutex(&Chain_Mutex1);
+
+	MYRTOS_Terminate_Task(&Chain_A);
+}
+
+void chain_task_b()
+{
+	MYRTOS_AcquireMutex(&Chain_Mutex1, &Chain_B);
+	MYRTOS_AcquireMutex(&Chain_Mutex2, &Chain_B);
+	Sim_Log("task_b owns Mutex2, priority %u", Chain_B.Priority);
+	Sim_Work(500);
+
+	MYRTOS_ReleaseMutex(&Chain_Mutex2);
+	Sim_Log("task_b released Mutex2, priority %u", Chain_B.Priority);
+	MYRTOS_ReleaseMutex(&Chain_Mutex1);
+	Sim_Log("task_b released Mutex1, priority %u", Chain_B.Priority);
+
+	MYRTOS_Terminate_Task(&Chain_B);
+}
+
+void chain_task_c()
+{
+	MYRTOS_AcquireMutex(&Chain_Mutex2, &Chain_C);
+
+	MYRTOS_Activate_Task(&Chain_B);
+	Sim_Log("task_b waits, task_c priority %u", Chain_C.Priority);
+	MYRTOS_Activate_Task(&Chain_A);
+	Sim_Log("task_a waits, task_b priority %u, task_c priority %u", Chain_B.Priority, Chain_C.Priority);
+
+	Sim_Log("task_c asks for Mutex1: %s", Sim_ErrorName(MYRTOS_AcquireMutex(&Chain_Mutex1, &Chain_C)));
+	Sim_Work(500);
+
+	MYRTOS_ReleaseMutex(&Chain_Mutex2);
+	Sim_Log("task_c released Mutex2, priority %u", Chain_C.Priority);
+
+	MYRTOS_Terminate_Task(&Chain_C);
+}
+
+void chain_Setup()
+{
+	Sim_Create(&Chain_A, chain_task_a, 1, "task_a");
+	Sim_Create(&Chain_B, chain_task_b, 3, "task_b");
+	Sim_Create(&Chain_C, chain_task_c, 5, "task_c");
+
+	MYRTOS_Activate_Task(&Chain_C);
+}
+
+
+
+// Boosted owner in a semaphore wait list
+// owner (priority 4) holds the mutex and waits for the semaphore behind mid (2). high (1) blocks on the
+// mutex: the owner inherits priority 1 and moves ahead of mid in the wait list of the semaphore, so the
+// interrupt's first give goes to it (then the mutex to high), and the second one to mid
+
+#define REQUEUE_TIMER_IRQn			29      // TIM3 of the STM32F103
+
+Task_Config Requeue_Owner, Requeue_Mid, Requeue_High;
+
+Mutex_Config Requeue_Mutex;
+MYRTOS_Semaphore_t Requeue_Event;
+
+void requeue_owner()
+{
+	MYRTOS_AcquireMutex(&Requeue_Mutex, &Requeue_Owner);
+	MYRTOS_Semaphore_Take(&Requeue_Event, MYRTOS_WAIT_FOREVER);
+	Sim_Log("owner got the semaphore, priority %u", Requeue_Owner.Priority);
+
+	MYRTOS_ReleaseMutex(&Requeue_Mutex);
+	Sim_Log("owner released the mutex, priority %u", Requeue_Owner.Priority);
+
+	MYRTOS_Terminate_Task(&Requeue_Owner);
+}
+
+void requeue_mid()
+{
+	MYRTOS_Task_Wait(1, &Requeue_Mid);
+
+	MYRTOS_Semaphore_Take(&Requeue_Event, MYRTOS_WAIT_FOREVER);
+	Sim_Log("mid got the semaphore");
+
+	MYRTOS_Terminate_Task(&Requeue_Mid);
+}
+
+void requeue_high()
+{
+	MYRTOS_Task_Wait(2, &Requeue_High);
+
+	MYRTOS_AcquireMutex(&Requeue_Mutex, &Requeue_High);
+	Sim_Log("high owns the mutex");
+	MYRTOS_ReleaseMutex(&Requeue_Mutex);
+
+	MYRTOS_Terminate_Task(&Requeue_High);
+}
+
+void requeue_timer()
+{
+	MYRTOS_TRACE_ISR_ENTER();
+
+	Sim_Log("timer interrupt gives the semaphore");
+	MYRTOS_Semaphore_Give(&Requeue_Event);
+
+	MYRTOS_TRACE_ISR_EXIT();
+}
+
+void requeue_Setup()
+{
+	MYRTOS_Semaphore_Init(&Requeue_Event, 0, 1);
+
+	Sim_Create(&Requeue_High, requeue_high, 1, "high");
+	Sim_Create(&Requeue_Mid, requeue_mid, 2, "mid");
+	Sim_Create(&Requeue_Owner, requeue_owner, 4, "owner");
+
+	MYRTOS_Activate_Task(&Requeue_High);
+	MYRTOS_Activate_Task(&Requeue_Mid);
+	MYRTOS_Activate_Task(&Requeue_Owner);
+
+	Sim_Raise_IRQ(3500, REQUEUE_TIMER_IRQn, requeue_timer);
+	Sim_Raise_IRQ(4500, REQUEUE_TIMER_IRQn, requeue_timer);
+}
+
+
+
+// Priority ceiling (ceiling 1)
+// task_lo (priority 4) is raised to the ceiling as soon as it acquires the mutex. task_mid (2) and task_hi (1),
+// activated meanwhile, run only after the release (task_hi has the priority of the ceiling, the owner still runs
+// first, across a tick), so task_hi finds the mutex free: no block, no boost. task_top (0), above the ceiling,
+// is refused
+
+Task_Config Ceiling_Top, Ceiling_Hi, Ceiling_Mid, Ceiling_Lo;
+
+Mutex_Config Ceiling_Mutex;
+
+void ceiling_User(Task_Config* P_Task)
+{
+	MYRTOS_errorID ErrorState;
+
+	ErrorState = MYRTOS_AcquireMutex(&Ceiling_Mutex, P_Task);
+	Sim_Log("%s takes the mutex: %s, priority %u", P_Task->TaskName, Sim_ErrorName(ErrorState), P_Task->Priority);
+	if(ErrorState == NO_ERROR)
+	{
+		Sim_Work(500);
+		MYRTOS_ReleaseMutex(&Ceiling_Mutex);
+	}
+
+	MYRTOS_Terminate_Task(P_Task);
+}
+
+void ceiling_task_top()
+{
+	ceiling_User(&Ceiling_Top);
+}
+
+void ceiling_task_hi()
+{
+	ceiling_User(&Ceiling_Hi);
+}
+
+void ceiling_task_mid()
+{
+	Sim_Log("task_mid runs");
+	Sim_Work(500);
+
+	MYRTOS_Terminate_Task(&Ceiling_Mid);
+}
+
+void ceiling_task_lo()
+{
+	MYRTOS_AcquireMutex(&Ceiling_Mutex, &Ceiling_Lo);
+	Sim_Log("task_lo takes the mutex, priority %u", Ceiling_Lo.Priority);
+
+	MYRTOS_Activate_Task(&Ceiling_Mid);
+	MYRTOS_Activate_Task(&Ceiling_Hi);
+	Sim_Work(1500);
+
+	Sim_Log("task_lo releases it");
+	MYRTOS_ReleaseMutex(&Ceiling_Mutex);
+	Sim_Log("task_lo priority %u", Ceiling_Lo.Priority);
+
+	MYRTOS_Activate_Task(&Ceiling_Top);
+
+	MYRTOS_Terminate_Task(&Ceiling_Lo);
+}
+
+void ceiling_Setup()
+{
+	strcpy(Ceiling_Mutex.MutexName, "Mutex ceiling");
+	Ceiling_Mutex.Protocol = Mutex_Ceiling;
+	Ceiling_Mutex.Ceiling_Priority = 1;
+
+	Sim_Create(&Ceiling_Top, ceiling_task_top, 0, "task_top");
+	Sim_Create(&Ceiling_Hi, ceiling_task_hi, 1, "task_hi");
+	Sim_Create(&Ceiling_Mid, ceiling_task_mid, 2, "task_mid");
+	Sim_Create(&Ceiling_Lo, ceiling_task_lo, 4, "task_lo");
+
+	MYRTOS_Activate_Task(&Ceiling_Lo);
+}
+
+
+
+const Sim_Scenario_t Sim_Scenarios[] = {
+	{"inversion", inversion_Setup, 20},
+	{"deadlock", deadlock_Setup, 20},
+	{"periodic", periodic_Setup, 200},
+	{"activate", activate_Setup, 30},
+	{"delete", delete_Setup, 25},
+	{"pool", pool_Setup, 8},
+	{"fifo", fifo_Setup, 30},
+	{"ring", ring_Setup, 10},
+	{"queue", queue_Setup, 20},
+	{"mail", mail_Setup, 24},
+	{"semaphore", semaphore_Setup, 16},
+	{"handoff", handoff_Setup, 8},
+	{"chain", chain_Setup, 6},
+	{"requeue", requeue_Setup, 8},
+	{"ceiling", ceiling_Setup, 6},
+};
+
+#define SIM_SCENARIOS_NUM			(sizeof(Sim_Scenarios) / sizeof(Sim_Scenarios[0]))
+
+
+
+int main(int argc, char* argv[])
+{
+	uint32_t i;
+	const Sim_Scenario_t* P_Scenario = NULL;
+
+	for(i=0 ; (argc > 1) && (i<SIM_SCENARIOS_NUM) ; i++)
+	{
+		if(strcmp(argv[1], Sim_Scenarios[i].Name) == 0)
+			P_Scenario = &Sim_Scenarios[i];
+	}
+
+	if(P_Scenario == NULL)
+	{
+		fprintf(stderr, "usage: %s <scenario> [-q] [-t <file>]\nscenarios:", argv[0]);
+		for(i=0 ; i<SIM_SCENARIOS_NUM ; i++)
+			fprintf(stderr, " %s", Sim_Scenarios[i].Name);
+		fprintf(stderr, "\n");
+		return EXIT_FAILURE;
+	}
+
+	for(i=2 ; i<(uint32_t)argc ; i++)
+	{
+		if(strcmp(argv[i], "-q") == 0)
+			Sim_Set_Timeline(0);
+		else if((strcmp(argv[i], "-t") == 0) && ((i + 1) < (uint32_t)argc))
+			Sim_Set_TraceFile(argv[++i]);
+	}
+
+	HW_Init();
+
+	if(MYRTOS_Init() != NO_ERROR)
+		return EXIT_FAILURE;
+
+	Sim_Set_Duration(P_Scenario->DurationTicks);
+	P_Scenario->P_Setup();
+
+	// Prints the report and exits at the end of the duration
+	MYRTOS_START_OS();
+
+	return EXIT_FAILURE;
+}
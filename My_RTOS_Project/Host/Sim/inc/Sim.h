@@ -0,0 +1,51 @@
+/*
+ * Sim.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Abdallah
+ */
+
+#ifndef INC_SIM_H_
+#define INC_SIM_H_
+
+#include "stdint.h"
+
+
+// Deterministic virtual time simulator of the kernel (host port with a virtual time source)
+// - Time moves forward only by Sim_Work() in the tasks, and by the idle task sleeping till the next tick
+// - The tick (Host_Tick, as from SysTick_Handler) runs synchronously when the virtual time reaches it,
+//   and so do the interrupts raised by the scenario (Sim_Raise_IRQ)
+// - So the same scenario gives the same timeline every run, on any machine
+//
+// Job of a task: from becoming ready (activation / end of a timed wait) till it waits for time or is terminated
+// (blocking on a mutex doesn't end the job), its response time is measured in virtual microseconds
+
+
+#define SIM_MAX_TASKS				32
+#define SIM_MAX_EVENTS				4096    // Context switches kept for the timeline
+#define SIM_MAX_IRQS				16      // Interrupts raised and not run yet
+
+
+
+/**================================================================
+ * @Fn					- Sim_Set_Duration
+ * @brief 				- Sets when the simulation ends (the report is printed then)
+ * @param [in] 			- Ticks: Length of the simulation in ticks
+ * @retval 				- None
+ * Note					- Call before MYRTOS_START_OS
+ */
+
+void Sim_Set_Duration(uint32_t Ticks);
+
+void Sim_Set_Timeline(uint8_t Enable);     // 1: the report starts with the context switches (default)
+void Sim_Set_TraceFile(const char* Path); // MYRTOS_TraceBuffer is written to Path at the end (MYRTOS_USE_TRACE)
+
+void Sim_Work(uint32_t Us);               // Simulated work of the running task (may be preempted by a tick)
+uint64_t Sim_Get_Time(void);              // Virtual time in microseconds
+void Sim_Log(const char* Format, ...);    // A line of the scenario at the virtual time (printed before the report)
+
+// P_Handler runs as the interrupt IRQn at TimeUs (the services it calls take their interrupt path)
+void Sim_Raise_IRQ(uint32_t TimeUs, uint16_t IRQn, void (*P_Handler)(void));
+
+
+#endif /* INC_SIM_H_ */
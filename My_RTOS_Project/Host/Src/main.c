@@ -0,0 +1,126 @@
+/*
+ * main.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Abdallah
+ */
+
+
+// Host demo of the kernel (same scheduling as on the board, tasks print instead of toggling pins)
+// Task1 and Task2 share the same priority (round robin), Task3 has a higher priority and waits between runs
+//   myrtos_host [-p <file>]      (-p: writes the profile to <file> at the end, see Tools/myrtos_profile.py)
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Schedular.h"
+#include "My_RTOS_Profiler.h"
+
+
+#define DEMO_RUN_TICKS			2000    // 2 seconds
+
+
+Task_Config Task1, Task2, Task3;
+
+volatile uint32_t Task1Counter, Task2Counter, Task3Counter;
+
+
+const char* ProfileFile;
+
+// MYRTOS_Profile as a dump of the target RAM
+void Write_Profile(void)
+{
+#if MYRTOS_USE_PROFILER
+	FILE* P_File = fopen(ProfileFile, "wb");
+
+	if((P_File == NULL) || (fwrite(&MYRTOS_Profile, sizeof(MYRTOS_Profile), 1, P_File) != 1))
+		fprintf(stderr, "myrtos_host: can't write %s\n", ProfileFile);
+	if(P_File != NULL)
+		fclose(P_File);
+#endif
+}
+
+
+void task1()
+{
+	while(1)
+	{
+		Task1Counter++;
+	}
+}
+
+void task2()
+{
+	while(1)
+	{
+		Task2Counter++;
+	}
+}
+
+void task3()
+{
+	while(1)
+	{
+		Task3Counter++;
+		printf("[%5u] task_3: task_1 %u, task_2 %u\n", MYRTOS_Get_SystemTicks(), Task1Counter, Task2Counter);
+#if MYRTOS_USE_STATISTICS
+		// CPU share in 0.01%
+		printf("        CPU: task_1 %u, task_2 %u, task_3 %u, idle %u\n", MYRTOS_Get_TaskUtilization(&Task1),
+				MYRTOS_Get_TaskUtilization(&Task2), MYRTOS_Get_TaskUtilization(&Task3), MYRTOS_Get_IdleUtilization());
+#endif
+
+		if(MYRTOS_Get_SystemTicks() >= DEMO_RUN_TICKS)
+			exit(EXIT_SUCCESS);
+
+		MYRTOS_Task_Wait(250, &Task3);
+	}
+}
+
+
+int main(int argc, char* argv[])
+{
+	MYRTOS_errorID Error = NO_ERROR;
+
+	if((argc > 2) && (strcmp(argv[1], "-p") == 0))
+	{
+		ProfileFile = argv[2];
+		atexit(Write_Profile);
+	}
+
+	HW_Init();
+
+	if(MYRTOS_Init() != NO_ERROR)
+		return EXIT_FAILURE;
+
+	Task1.Stack_Size = 1024;
+	Task1.P_TaskEntry = task1;
+	Task1.Priority = 4;
+	strcpy(Task1.TaskName, "task_1");
+
+	Task2.Stack_Size = 1024;
+	Task2.P_TaskEntry = task2;
+	Task2.Priority = 4;
+	strcpy(Task2.TaskName, "task_2");
+
+	Task3.Stack_Size = 1024;
+	Task3.P_TaskEntry = task3;
+	Task3.Priority = 1;
+	strcpy(Task3.TaskName, "task_3");
+
+	Error += MYRTOS_Create_Task(&Task1);
+	Error += MYRTOS_Create_Task(&Task2);
+	Error += MYRTOS_Create_Task(&Task3);
+
+	if(Error != NO_ERROR)
+		return EXIT_FAILURE;
+
+	MYRTOS_Activate_Task(&Task1);
+	MYRTOS_Activate_Task(&Task2);
+	MYRTOS_Activate_Task(&Task3);
+
+	MYRTOS_START_OS();
+
+	return EXIT_FAILURE;
+}
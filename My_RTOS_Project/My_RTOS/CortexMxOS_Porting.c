@@ -8,6 +8,7 @@
 #include "CortexMxOS_Porting.h"
 #include "Schedular.h"
 #include "Schedular_Private.h"
+#include "My_RTOS_Profiler.h"
 
 
 
@@ -113,6 +114,71 @@ __attribute ((naked))  void SVC_Handler()
 }
 
 
+/**
+ * @Fn       			- PendSV_Handler
+ * @brief    			- A naked assembly function that switches context from OS_Control.CurrentTaskExecuted
+ *           			to OS_Control.NextTaskTobeExecuted. R4 to R11 are saved and restored on the process
+ *           			stack with one stmdb/ldmia each (xpsr --> r0 are pushed/popped by the processor).
+ * @param [in] 			- None
+ * @retval   			- None
+ * @note     			- Nothing is saved or restored if there is no next task, or it is the current task.
+ * 						 With MYRTOS_USE_STATISTICS / MYRTOS_USE_TRACE, MYRTOS_PendSV_Hook runs first.
+ * 						 With MYRTOS_USE_STACK_CHECK, a stack overflow of the current task branches to MYRTOS_Stack_Overflow.
+ * 						 The offsets of OS_Control and Task_Config used here are checked in Schedular.c
+ */
+
+__attribute ((naked)) void PendSV_Handler()
+{
+	__asm("movw r0,#:lower16:OS_Control \n\t"
+			"movt r0,#:upper16:OS_Control \n\t"
+			"cpsid i \n\t"
+			"ldrd r1,r2,[r0] \n\t"			// r1 = CurrentTaskExecuted, r2 = NextTaskTobeExecuted
+			"cbz r2,1f \n\t"
+			"movs r3,#0 \n\t"
+			"str r3,[r0,#4] \n\t"			// NextTaskTobeExecuted = NULL
+#if MYRTOS_PENDSV_HOOK
+			// Statistics and trace of the switch (on every tick, the cycle counter is 32 bit)
+			"push {r0-r2,lr} \n\t"
+			"mov r0,r1 \n\t"
+			"mov r1,r2 \n\t"
+			"bl MYRTOS_PendSV_Hook \n\t"
+			"pop {r0-r2,lr} \n\t"
+#endif
+			"cmp r1,r2 \n\t"
+			"beq 1f \n\t"
+
+			// Save context of the current task
+			"mrs r3,psp \n\t"
+			"stmdb r3!,{r4-r11} \n\t"
+			"str r3,[r1] \n\t"				// Current->Current_PSP
+#if MYRTOS_USE_STACK_CHECK
+			// Stack check of the current task: the saved frame ends above its guard word, which is intact
+			"ldr r12,[r1,#" OS_STRINGIFY(MYRTOS_TASK_E_PSP_OFFSET) "] \n\t"	// Current->_E_PSP_Task (guard word)
+			"cmp r3,r12 \n\t"
+			"bls 2f \n\t"
+			"ldr r3,[r12] \n\t"
+			"cmp r3,#" OS_STRINGIFY(MYRTOS_STACK_PATTERN) " \n\t"
+			"bne 2f \n\t"
+#endif
+
+			// Restore context of the next task
+			"ldr r3,[r2] \n\t"				// Next->Current_PSP
+			"ldmia r3!,{r4-r11} \n\t"
+			"msr psp,r3 \n\t"
+			"str r2,[r0] \n\t"				// CurrentTaskExecuted = Next
+
+			"1: \n\t"
+			"cpsie i \n\t"
+			"bx lr \n\t"
+#if MYRTOS_USE_STACK_CHECK
+			"2: \n\t"
+			"mov r0,r1 \n\t"
+			"b MYRTOS_Stack_Overflow"
+#endif
+			);
+}
+
+
 /**
  * @Fn       			- Trigger_OS_PendSV
  * @brief    			- Triggers a PendSV exception request, which is used for context switching in an OS.
@@ -129,11 +195,96 @@ void Trigger_OS_PendSV()
 }
 
 
+/**================================================================
+ * @Fn                - MYRTOS_Create_Stack
+ * @brief             - Creates a stack for a task in the MYRTOS
+ * @param [in]        - taskReference: Pointer to the task configuration structure
+ * @retval            - MYRTOS_errorID: Error code indicating the result of stack creation
+ * Note              - This function should be called when defining and creating a task to allocate a stack for it.
+ */
+
+
+void MYRTOS_Create_Stack(Task_Config* taskReference)
+{
+	/** Task Frame
+	 * 	//// (Automatically pushed by processor)
+	 * 	- xpsr
+	 * 	- pc (next instrcution to be executed to this task)
+	 * 	- lr (Return register which is saved in cpu while task running before switching)
+	 * 	- r12
+	 * 	- r4
+	 * 	- r3
+	 * 	- r2
+	 * 	- r1
+	 * 	- r0
+	 *
+	 * 	//// (Manually defined to save the value of registers (Manually pushed and restored))
+	 * 	r5, r6, r7, r8, r9, r10, r11
+	 */
+	taskReference->Current_PSP = (uint32_t *)(taskReference->_S_PSP_Task);
+
+	taskReference->Current_PSP--;
+	*(taskReference->Current_PSP) = 0x01000000;  // Dummy psr (by default T=1 Thumb2) to avoid bus fault
+
+	taskReference->Current_PSP--;
+	*(taskReference->Current_PSP) = (unsigned int)(taskReference->P_TaskEntry);   // PC value
+
+	taskReference->Current_PSP--;
+	*(taskReference->Current_PSP) = (unsigned int)(0xFFFFFFFD);   // (Dummy value)As if LR (This function came from interrupt
+
+	// The rest is 13 registers we want to push with 0 for now
+	for(int j=0;j<13;j++)
+	{
+		taskReference->Current_PSP--;
+		*(taskReference->Current_PSP) = 0;
+	}
+}
+
+
+
+#if MYRTOS_USE_TASK_DELETE
+/**================================================================
+ * @Fn					- MYRTOS_Delete_Stack
+ * @brief 				- Releases what the port holds for a deleted task
+ * @param [in] 			- taskReference: Pointer to the task configuration structure
+ * @retval 				- None
+ * Note					- Nothing on Cortex-M, the process stack itself goes back to the kernel (MYRTOS_Stack_Free)
+ */
+
+void MYRTOS_Delete_Stack(Task_Config* taskReference)
+{
+	(void)taskReference;
+}
+#endif
+
+
+
+/**================================================================
+ * @Fn					- Start_FirstTask
+ * @brief 				- Switches thread mode to the process stack of the first task, then runs it.
+ * @param [in] 			- taskReference: The first task (Idle task)
+ * @retval 				- None
+ * Note					- Never returns, tasks run unprivileged unless MYRTOS_PRIVILEGED_TASKS is set.
+ */
+
+void Start_FirstTask(Task_Config* taskReference)
+{
+	OS_SET_PSP(taskReference->Current_PSP);
+
+	// Switch thread mode from MSP to PSP
+	OS_SWITCH_SP_to_PSP;
+#if !MYRTOS_PRIVILEGED_TASKS
+	OS_SWITCH_TO_UNPRIVILIGE;
+#endif
+	taskReference->P_TaskEntry();
+}
+
+
+
 /**================================================================
  * @Fn					- HW_Init
  * @brief 				- This function sets up the clock tree for an 8 MHz system clock (by default) and
- * 							adjusts NVIC priorities, specifically lowering the priority of the PendSV interrupt
- * 							to be less than or equal to the SysTick timer (priority 14).
+ * 							adjusts NVIC priorities, SVC at OS_KERNEL_PRIORITY (14) and PendSV below it (15).
  * @param [in] 			- None
  * @retval 				- None
  * Note					- None
@@ -150,10 +301,19 @@ void HW_Init()
 	// X count -> 1ms
 	// X = 8000 counts
 
-	// Decrease priority of pendSV to be less than or equal systick timer
-	// systick = 14
+	// SVC, SysTick (Start_Ticker) and the interrupts calling the kernel share one priority
+	__NVIC_SetPriority(SVCall_IRQn,OS_KERNEL_PRIORITY);
 
+	// Decrease priority of pendSV to be less than systick timer
+	// systick = 14
 	__NVIC_SetPriority(PendSV_IRQn,15);
+
+#if MYRTOS_USE_STATISTICS || MYRTOS_USE_TRACE
+	// Cycle counter of the run time statistics and the trace timestamps
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
 }
 
 
@@ -176,13 +336,112 @@ void Start_Ticker()
 	// X count -> 1ms
 	// X = 8000 counts
 
-	SysTick_Config(8000);
+	SysTick_Config(TICKER_COUNTS_PER_TICK);
 
+	// SysTick_Config gives it the least priority (15), back to the one of SVC
+	__NVIC_SetPriority(SysTick_IRQn,OS_KERNEL_PRIORITY);
 }
 
 
 uint8_t SystTickIndication;
 
+// Ticks covered by the current SysTick period (more than one during tickless idle)
+uint32_t Ticker_PeriodTicks = 1;
+
+
+
+/**================================================================
+ * @Fn					- Ticker_Restart
+ * @brief 				- Makes the next SysTick interrupt come Counts after now, the following ones every tick.
+ * @param [in] 			- Counts: SysTick counts till the next interrupt (2 at least)
+ * @retval 				- None
+ * Note					- The counter takes LOAD on the clock after VAL is written, so LOAD is set back to one tick
+ * 						 once it did. The few cycles between reading VAL and writing it are the only time lost.
+ */
+
+void Ticker_Restart(uint32_t Counts)
+{
+	SysTick->LOAD = Counts - 1;
+	SysTick->VAL = 0;
+
+	// Wait for the reload (one clock), the periods after this one are of one tick
+	while(SysTick->VAL == 0)
+	{
+	}
+	SysTick->LOAD = TICKER_COUNTS_PER_TICK - 1;
+}
+
+
+
+/**================================================================
+ * @Fn					- Ticker_Suppress
+ * @brief 				- Stretches the current SysTick period to TicksNum ticks (tickless idle).
+ * @param [in] 			- TicksNum: Number of ticks only the idle task will run
+ * @retval 				- None
+ * Note					- Called from SysTick_Handler at a tick boundary, periods longer than the 24 bit
+ * 						 counter are split, the idle task is interrupted at TICKER_MAX_TICKS and stretched again.
+ */
+
+void Ticker_Suppress(uint32_t TicksNum)
+{
+	uint32_t ElapsedCounts;
+
+	// Not worth stopping the ticker
+	if(TicksNum < 2)
+		return;
+
+	if(TicksNum > TICKER_MAX_TICKS)
+		TicksNum = TICKER_MAX_TICKS;
+
+	// Counts of the current tick already passed (the period still ends on a tick boundary, no drift)
+	ElapsedCounts = (TICKER_COUNTS_PER_TICK - 1) - SysTick->VAL;
+
+	Ticker_Restart((TicksNum * TICKER_COUNTS_PER_TICK) - ElapsedCounts);
+	Ticker_PeriodTicks = TicksNum;
+}
+
+
+
+/**================================================================
+ * @Fn					- Ticker_Resume
+ * @brief 				- Ends a tickless idle period before its time (a task became ready from an interrupt).
+ * @param [in] 			- None
+ * @retval 				- Number of whole ticks passed since the period started
+ * Note					- The next SysTick interrupt is kept on a tick boundary, so wake up times stay exact.
+ */
+
+uint32_t Ticker_Resume()
+{
+	uint32_t RemainingCounts, ElapsedCounts, NextCounts, TicksNum;
+
+	// Ticking normally, or the period already expired (SysTick_Handler will count it)
+	if((Ticker_PeriodTicks == 1) || (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk))
+		return 0;
+
+	// LOAD is back to one tick already, the period ends when VAL reaches 0
+	RemainingCounts = SysTick->VAL;
+	ElapsedCounts = (Ticker_PeriodTicks * TICKER_COUNTS_PER_TICK) - RemainingCounts;
+	TicksNum = ElapsedCounts / TICKER_COUNTS_PER_TICK;
+
+	// Interrupt on the next tick boundary (the one after if it is too close), SysTick_Handler counts the rest
+	NextCounts = RemainingCounts % TICKER_COUNTS_PER_TICK;
+	Ticker_PeriodTicks = 1;
+	if(NextCounts == 0)
+	{
+		// On a boundary now, TicksNum counted it
+		NextCounts = TICKER_COUNTS_PER_TICK;
+	}
+	else if(NextCounts < 2)
+	{
+		NextCounts += TICKER_COUNTS_PER_TICK;
+		Ticker_PeriodTicks = 2;
+	}
+
+	Ticker_Restart(NextCounts);
+
+	return TicksNum;
+}
+
 
 /**
  * @Fn       			- SysTick_Handler
@@ -190,15 +449,50 @@ uint8_t SystTickIndication;
  *           			deciding the next task to run, and triggering a PendSV exception to switch context and restore.
  * @param [in] 			- None
  * @retval   			- None
- * @note     			- None
+ * @note     			- When only the idle task is ready, the next interrupt is delayed till the next wake up time.
+ * 						 With MYRTOS_USE_PROFILER, a naked SysTick_Handler passes the stacked frame of the interrupted
+ * 						 code and EXC_RETURN to Ticker_Handler (same job), which samples the interrupted PC.
  */
 
+#if MYRTOS_USE_PROFILER
+__attribute ((naked)) void SysTick_Handler()
+{
+	// Check EXC_Return to see if you were MSP or PSP (as SVC_Handler)
+	__asm("tst lr,#4 \n\t"
+			"ITE EQ \n\t"
+			"mrseq r0,MSP \n\t"
+			"mrsne r0,PSP \n\t"
+			"mov r1,lr \n\t"
+			"B Ticker_Handler");
+}
+
+void Ticker_Handler(uint32_t* StackFramePointer, uint32_t ExcReturn)
+#else
 void SysTick_Handler(void)
+#endif
 {
+	uint32_t TicksNum = Ticker_PeriodTicks;
+
 	SystTickIndication ^= 1;
-	MYRTOS_Update_Tasks_WaitingTime();
+
+#if MYRTOS_USE_PROFILER
+	// Stacked frame --> r0,r1,r2,r3,r12,lr,pc,xpsr, EXC_RETURN 0xFFFFFFF1: a handler was interrupted
+	MYRTOS_Profiler_Sample(StackFramePointer[6], ((ExcReturn & 0xF) == 0x1), TicksNum);
+#endif
+
+
+	// Back to 1ms period after a tickless idle period (LOAD is of one tick already, see Ticker_Restart)
+	Ticker_PeriodTicks = 1;
+
+	MYRTOS_Update_Tasks_WaitingTime(TicksNum);
+	// Time slice: the next task of the same priority runs
+	MYRTOS_RoundRobin();
 	// Decide what Next (To determine Pcurrent, Pnext)
 	Decide_WhatNextTask();
 	// Trigger PendSv(Switch Context & Restore)
 	Trigger_OS_PendSV();
+
+#if MYRTOS_TICKLESS_IDLE
+	Ticker_Suppress(MYRTOS_Get_IdleTicks());
+#endif
 }
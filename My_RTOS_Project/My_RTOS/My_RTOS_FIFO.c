@@ -8,33 +8,36 @@
 
 #include "My_RTOS_FIFO.h"
 
+#include "string.h"
+
 
 
 /**================================================================
  * @Fn                - FIFO_Init
  * @brief             - Initializes a FIFO (First-In-First-Out) buffer
  * @param [in]        - fifo: Pointer to the FIFO buffer structure
- * @param [in]        - Buffer: Pointer to the data buffer
- * @param [in]        - length: Maximum number of elements the FIFO can hold
- * @retval            - FIFO_Status: Status code indicating the result of initialization
+ * @param [in]        - Buffer: Pointer to the data buffer (length * element_size bytes, FIFO_BUFFER)
+ * @param [in]        - element_size: Bytes of an element
+ * @param [in]        - length: Maximum number of elements the FIFO can hold (a power of two)
+ * @retval            - FIFO_Status: FIFO_Null (no buffer), FIFO_Invalid_Length (not a power of two)
  * Note              - Call this function to initialize a FIFO buffer for data storage.
  */
 
-FIFO_Status FIFO_Init(FIFO_Buffer_t *fifo, Element_Type* Buffer, uint32_t length)
+FIFO_Status FIFO_Init(FIFO_Buffer_t *fifo, void* Buffer, uint32_t element_size, uint32_t length)
 {
-	if(!Buffer)
+	if(!Buffer || !element_size)
 		return FIFO_Null;
 
+	if(!length || (length & (length - 1)))
+		return FIFO_Invalid_Length;
 
-	fifo->base = Buffer;
-	fifo->head = fifo->base;
-	fifo->tail = fifo->base;
-	fifo->length = length;
-	fifo->counter = 0;
+	fifo->base = (uint8_t*)Buffer;
+	fifo->element_size = element_size;
+	fifo->mask = length - 1;
+	fifo->head = 0;
+	fifo->tail = 0;
 
 	return FIFO_No_Error;
-
-
 }
 
 
@@ -43,33 +46,18 @@ FIFO_Status FIFO_Init(FIFO_Buffer_t *fifo, Element_Type* Buffer, uint32_t length
  * @Fn                - FIFO_Enqueue
  * @brief             - Enqueues an item into the FIFO buffer
  * @param [in]        - fifo: Pointer to the FIFO buffer structure
- * @param [in]        - Item: Element to be enqueued
+ * @param [in]        - Item: Pointer to the element to be enqueued (element_size bytes are copied)
  * @retval            - FIFO_Status: Status code indicating the result of the enqueue operation
  * Note              - Call this function to add an element to the FIFO buffer.
  */
 
-
-
-FIFO_Status FIFO_Enqeue(FIFO_Buffer_t *fifo, Element_Type Item)
+FIFO_Status FIFO_Enqeue(FIFO_Buffer_t *fifo, const void* Item)
 {
-	// Check if the FIFO is valid
-	if(!fifo->base || !fifo->length)
-		return FIFO_Null;
-
-	// Full FIFO
-	if((fifo->head == fifo->tail) && (fifo->counter == fifo->length))
+	if(FIFO_Count(fifo) > fifo->mask)
 		return FIFO_Full;
 
-
-	*(fifo->tail) = Item;
-	fifo->counter++;
-
-
-	// Handle Circular Queue
-	if((uint32_t)fifo->tail == (((uint32_t)fifo->base + (4*fifo->length)) - 4))
-		fifo->tail = fifo->base;
-	else
-		fifo->tail++;
+	memcpy(FIFO_ELEMENT(fifo, fifo->tail), Item, fifo->element_size);
+	fifo->tail++;
 
 	return FIFO_No_Error;
 }
@@ -80,39 +68,89 @@ FIFO_Status FIFO_Enqeue(FIFO_Buffer_t *fifo, Element_Type Item)
  * @Fn                - FIFO_Dequeue
  * @brief             - Dequeues an item from the FIFO buffer
  * @param [in]        - fifo: Pointer to the FIFO buffer structure
- * @param [out]       - Item: Pointer to store the dequeued element
+ * @param [out]       - Item: Pointer to store the dequeued element (element_size bytes)
  * @retval            - FIFO_Status: Status code indicating the result of the dequeue operation
  * Note              - Call this function to remove an element from the FIFO buffer.
  */
 
+FIFO_Status FIFO_Deqeue(FIFO_Buffer_t *fifo, void* Item)
+{
+	if(fifo->head == fifo->tail)
+		return FIFO_Empty;
+
+	memcpy(Item, FIFO_ELEMENT(fifo, fifo->head), fifo->element_size);
+	fifo->head++;
+
+	return FIFO_No_Error;
+}
+
 
 
+/**================================================================
+ * @Fn                - FIFO_Enqeue_Batch
+ * @brief             - Enqueues up to Num items in one call
+ * @param [in]        - fifo: Pointer to the FIFO buffer structure
+ * @param [in]        - Items: Array of Num elements
+ * @param [in]        - Num: Number of elements to enqueue
+ * @retval            - uint32_t: Elements enqueued (less than Num if the FIFO became full)
+ * Note              - Two copies at most (before and after the end of the buffer)
+ */
 
-FIFO_Status FIFO_Deqeue(FIFO_Buffer_t *fifo, Element_Type* Item)
+uint32_t FIFO_Enqeue_Batch(FIFO_Buffer_t *fifo, const void* Items, uint32_t Num)
 {
-	// Check if the FIFO is valid
-	if(!fifo->base || !fifo->length)
-		return FIFO_Null;
+	uint32_t Index = fifo->tail & fifo->mask;
+	uint32_t First;
 
-	// Empty FIFO(Nothing to deqeue)
-	if(fifo->head == fifo->tail)
-		return FIFO_Empty;
+	if(Num > FIFO_Free(fifo))
+		Num = FIFO_Free(fifo);
 
-	*Item = *(fifo->head);
-	fifo->counter--;
+	// Till the end of the buffer, then the rest from its start
+	First = fifo->mask + 1 - Index;
+	if(First > Num)
+		First = Num;
 
+	memcpy(fifo->base + (Index * fifo->element_size), Items, First * fifo->element_size);
+	memcpy(fifo->base, (const uint8_t*)Items + (First * fifo->element_size), (Num - First) * fifo->element_size);
 
-	// Circular deqeue
-	if((uint32_t)(fifo->head) == (((uint32_t)fifo->base + (4*fifo->length)) - 4))
-		fifo->head = fifo->base;
-	else
-		fifo->head++;
+	fifo->tail += Num;
 
-	return FIFO_No_Error;
+	return Num;
+}
+
+
+
+/**================================================================
+ * @Fn                - FIFO_Deqeue_Batch
+ * @brief             - Dequeues up to Num items in one call
+ * @param [in]        - fifo: Pointer to the FIFO buffer structure
+ * @param [out]       - Items: Array of Num elements
+ * @param [in]        - Num: Number of elements to dequeue
+ * @retval            - uint32_t: Elements dequeued (less than Num if the FIFO became empty)
+ * Note              - Two copies at most (before and after the end of the buffer)
+ */
+
+uint32_t FIFO_Deqeue_Batch(FIFO_Buffer_t *fifo, void* Items, uint32_t Num)
+{
+	uint32_t Index = fifo->head & fifo->mask;
+	uint32_t First;
+
+	if(Num > FIFO_Count(fifo))
+		Num = FIFO_Count(fifo);
 
+	First = fifo->mask + 1 - Index;
+	if(First > Num)
+		First = Num;
+
+	memcpy(Items, fifo->base + (Index * fifo->element_size), First * fifo->element_size);
+	memcpy((uint8_t*)Items + (First * fifo->element_size), fifo->base, (Num - First) * fifo->element_size);
+
+	fifo->head += Num;
+
+	return Num;
 }
 
 
+
 /**================================================================
  * @Fn                - FIFO_Is_Full
  * @brief             - Checks if the FIFO buffer is full
@@ -123,11 +161,10 @@ FIFO_Status FIFO_Deqeue(FIFO_Buffer_t *fifo, Element_Type* Item)
 
 FIFO_Status FIFO_Is_Full(FIFO_Buffer_t *fifo)
 {
-
-	if(!fifo->head || !fifo->base || !fifo->tail)
+	if(!fifo->base)
 		return FIFO_Null;
 
-	if(fifo->counter == fifo->length)
+	if(FIFO_Count(fifo) > fifo->mask)
 		return FIFO_Full;
 
 	return FIFO_No_Error;
@@ -0,0 +1,172 @@
+/*
+ * My_RTOS_Mail.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Abdallah
+ */
+
+#include "Schedular.h"
+#include "Schedular_Private.h"
+#include "My_RTOS_Mail.h"
+
+#include "stddef.h"
+
+
+#if MYRTOS_USE_MAIL
+
+// Header of the mail (the data follows it)
+#define MAIL_HEADER(Mail)			((MYRTOS_MailHeader_t*)(Mail) - 1)
+
+
+
+/**================================================================
+ * @Fn                - MYRTOS_Mailbox_Init
+ * @brief             - Initializes an empty mailbox
+ * @param [in]        - Mailbox: Pointer to the mailbox
+ * @param [in]        - Storage: Length pointers (MYRTOS_MAILBOX_STORAGE)
+ * @param [in]        - Length: Number of mails it holds (a power of two)
+ * @retval            - MYRTOS_errorID: Queue_Invalid_Config
+ * Note              - None
+ */
+
+MYRTOS_errorID MYRTOS_Mailbox_Init(MYRTOS_Mailbox_t* Mailbox, void* Storage, uint32_t Length)
+{
+	return MYRTOS_Queue_Init(Mailbox, Storage, sizeof(void*), Length);
+}
+
+
+
+/**================================================================
+ * @Fn                - MYRTOS_SVC_MailRef
+ * @brief             - Adds to the references of a mail (Handler Mode), called through SVC_Table
+ * @param [in]        - Args: Stacked r0-r3 of the caller (Args[0]: the mail, Args[1]: references to add, signed)
+ * @retval            - MYRTOS_errorID, written back to the stacked r0 (Mail_Invalid_Release: no reference left to drop)
+ * Note               - In the kernel, so consumers releasing the same mail don't race. The block is
+ *                      freed when no reference is left
+ */
+
+uintptr_t MYRTOS_SVC_MailRef(uintptr_t* Args)
+{
+	MYRTOS_MailHeader_t* P_Header = MAIL_HEADER(Args[0]);
+	int32_t Delta = (int32_t)Args[1];
+
+	// More releases than references (released twice, or already back in its pool)
+	if((Delta < 0) && ((uint32_t)(-Delta) > P_Header->RefCount))
+		return Mail_Invalid_Release;
+
+	P_Header->RefCount += (uint32_t)Delta;
+	if(P_Header->RefCount != 0)
+		return NO_ERROR;
+
+	return MYRTOS_Pool_Put(P_Header->P_Pool, P_Header);
+}
+
+
+
+/**================================================================
+ * @Fn                - MYRTOS_Mail_Alloc
+ * @brief             - Takes a mail from a pool, the caller has its only reference
+ * @param [in]        - Pool: Pool of blocks of MYRTOS_MAIL_BLOCK_SIZE(DataSize) bytes
+ * @param [in]        - Timeout: Ticks to wait if the pool is empty (MYRTOS_NO_WAIT, MYRTOS_WAIT_FOREVER)
+ * @retval            - void*: The data of the mail (NULL: the pool is empty or the timeout passed)
+ * Note              - From an interrupt it never waits
+ */
+
+void* MYRTOS_Mail_Alloc(MYRTOS_Pool_t* Pool, uint32_t Timeout)
+{
+	MYRTOS_MailHeader_t* P_Header = (MYRTOS_MailHeader_t*)MYRTOS_Pool_Alloc(Pool, Timeout);
+
+	if(P_Header == NULL)
+		return NULL;
+
+	P_Header->P_Pool = Pool;
+	P_Header->RefCount = 1;
+
+	return P_Header + 1;
+}
+
+
+
+/**================================================================
+ * @Fn                - MYRTOS_Mail_Post
+ * @brief             - Posts a mail to a mailbox, its reference goes to the consumer
+ * @param [in]        - Mailbox: Pointer to the mailbox
+ * @param [in]        - Mail: A mail of the caller (MYRTOS_Mail_Alloc)
+ * @param [in]        - Timeout: Ticks to wait if the mailbox is full (MYRTOS_NO_WAIT, MYRTOS_WAIT_FOREVER)
+ * @retval            - MYRTOS_errorID: Queue_Full (it can't wait), Timeout_Expired
+ * Note              - Only the pointer is copied. If it fails, the caller still has the mail
+ */
+
+MYRTOS_errorID MYRTOS_Mail_Post(MYRTOS_Mailbox_t* Mailbox, void* Mail, uint32_t Timeout)
+{
+	return MYRTOS_Queue_Send(Mailbox, &Mail, Timeout);
+}
+
+
+
+/**================================================================
+ * @Fn                - MYRTOS_Mail_Broadcast
+ * @brief             - Posts a mail to several mailboxes, each consumer gets a reference
+ * @param [in]        - Mailboxes: Array of MailboxesNum mailboxes
+ * @param [in]        - MailboxesNum: Number of mailboxes
+ * @param [in]        - Mail: A mail of the caller (MYRTOS_Mail_Alloc), its reference is given away
+ * @param [in]        - Timeout: Ticks to wait for each full mailbox (MYRTOS_NO_WAIT, MYRTOS_WAIT_FOREVER)
+ * @retval            - MYRTOS_errorID: The error of the last mailbox missed (Queue_Full, Timeout_Expired)
+ * Note              - The mailboxes missed get nothing, their references are released
+ */
+
+MYRTOS_errorID MYRTOS_Mail_Broadcast(MYRTOS_Mailbox_t* const Mailboxes[], uint32_t MailboxesNum, void* Mail, uint32_t Timeout)
+{
+	MYRTOS_errorID ErrorState = NO_ERROR, PostState;
+	uint32_t i;
+
+	// One reference for each mailbox, the one of the caller included (all taken before the first
+	// consumer can release the mail)
+	MYRTOS_SVC(SVC_MailRef, Mail, MailboxesNum - 1);
+
+	for(i = 0; i < MailboxesNum; i++)
+	{
+		PostState = MYRTOS_Queue_Send(Mailboxes[i], &Mail, Timeout);
+		if(PostState != NO_ERROR)
+		{
+			ErrorState = PostState;
+			MYRTOS_Mail_Release(Mail);
+		}
+	}
+
+	return ErrorState;
+}
+
+
+
+/**================================================================
+ * @Fn                - MYRTOS_Mail_Fetch
+ * @brief             - Takes the oldest mail of a mailbox, with its reference
+ * @param [in]        - Mailbox: Pointer to the mailbox
+ * @param [out]       - P_Mail: Pointer to store the mail
+ * @param [in]        - Timeout: Ticks to wait if the mailbox is empty (MYRTOS_NO_WAIT, MYRTOS_WAIT_FOREVER)
+ * @retval            - MYRTOS_errorID: Queue_Empty (it can't wait), Timeout_Expired
+ * Note              - The consumer releases the mail when done with it (MYRTOS_Mail_Release)
+ */
+
+MYRTOS_errorID MYRTOS_Mail_Fetch(MYRTOS_Mailbox_t* Mailbox, void** P_Mail, uint32_t Timeout)
+{
+	return MYRTOS_Queue_Receive(Mailbox, P_Mail, Timeout);
+}
+
+
+
+/**================================================================
+ * @Fn                - MYRTOS_Mail_Release
+ * @brief             - Drops a reference to a mail, the last one frees its block
+ * @param [in]        - Mail: A mail referenced by the caller
+ * @retval            - MYRTOS_errorID: Pool_Invalid_Block, Mail_Invalid_Release (the mail has no reference left)
+ * Note              - Callable from interrupts
+ */
+
+MYRTOS_errorID MYRTOS_Mail_Release(void* Mail)
+{
+	return MYRTOS_SVC(SVC_MailRef, Mail, -1);
+}
+
+#endif
@@ -0,0 +1,172 @@
+/*
+ * My_RTOS_MemPool.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Abdallah
+ */
+
+#include "Schedular.h"
+#include "Schedular_Private.h"
+#include "My_RTOS_MemPool.h"
+
+#include "stddef.h"
+
+
+#if MYRTOS_USE_MEMPOOL
+
+/**================================================================
+ * @Fn                - MYRTOS_Pool_Init
+ * @brief             - Links all the blocks of the storage in the free list of the pool
+ * @param [in]        - Pool: Pointer to the pool
+ * @param [in]        - Storage: BlocksNum blocks of MYRTOS_POOL_BLOCK_SIZE(BlockSize) bytes, aligned to a pointer
+ *                      (MYRTOS_POOL_STORAGE)
+ * @param [in]        - BlockSize: Bytes of a block
+ * @param [in]        - BlocksNum: Number of blocks
+ * @retval            - MYRTOS_errorID: Pool_Invalid_Config (no storage, no blocks or storage not aligned)
+ * Note              - Call it before any task or interrupt uses the pool
+ */
+
+MYRTOS_errorID MYRTOS_Pool_Init(MYRTOS_Pool_t* Pool, void* Storage, uint32_t BlockSize, uint32_t BlocksNum)
+{
+	uint8_t* P_Block;
+
+	if((Storage == NULL) || (BlockSize == 0) || (BlocksNum == 0) || (((uintptr_t)Storage % sizeof(uintptr_t)) != 0))
+		return Pool_Invalid_Config;
+
+	Pool->P_Storage = (uint8_t*)Storage;
+	Pool->BlockSize = MYRTOS_POOL_BLOCK_SIZE(BlockSize);
+	Pool->BlocksNum = BlocksNum;
+	Pool->FreeBlocksNum = BlocksNum;
+	Pool->MinFreeBlocksNum = BlocksNum;
+	Pool->P_Waiters = NULL;
+
+	// The first block is allocated first
+	Pool->P_FreeList = NULL;
+	P_Block = Pool->P_Storage + (Pool->BlockSize * BlocksNum);
+	while(P_Block != Pool->P_Storage)
+	{
+		P_Block -= Pool->BlockSize;
+		*(void**)P_Block = Pool->P_FreeList;
+		Pool->P_FreeList = P_Block;
+	}
+
+	return NO_ERROR;
+}
+
+
+
+/**================================================================
+ * @Fn                - MYRTOS_SVC_PoolAlloc
+ * @brief             - Memory pool services (Handler Mode), called through SVC_Table
+ * @param [in]        - Args: Stacked r0-r3 of the caller (Args[0]: the pool)
+ * @retval            - Written back to the stacked r0
+ * Note               - None
+ */
+
+// Args[1]: Timeout, returns the block (NULL: the pool is empty or the timeout passed)
+uintptr_t MYRTOS_SVC_PoolAlloc(uintptr_t* Args)
+{
+	MYRTOS_Pool_t* Pool = (MYRTOS_Pool_t*)Args[0];
+	void* P_Block = Pool->P_FreeList;
+
+	if(P_Block != NULL)
+	{
+		Pool->P_FreeList = *(void**)P_Block;
+		Pool->FreeBlocksNum--;
+		if(Pool->FreeBlocksNum < Pool->MinFreeBlocksNum)
+			Pool->MinFreeBlocksNum = Pool->FreeBlocksNum;
+
+		return (uintptr_t)P_Block;
+	}
+
+	// Empty: wait for a block (MYRTOS_SVC_PoolFree writes it to the stacked r0 of the task)
+	MYRTOS_WaitList_Block(&Pool->P_Waiters, Args, (uint32_t)Args[1]);
+
+	return (uintptr_t)NULL;
+}
+
+// Args[1]: The block
+uintptr_t MYRTOS_SVC_PoolFree(uintptr_t* Args)
+{
+	return MYRTOS_Pool_Put((MYRTOS_Pool_t*)Args[0], (void*)Args[1]);
+}
+
+
+
+/**================================================================
+ * @Fn                - MYRTOS_Pool_Put
+ * @brief             - Gives a block back to its pool (Handler Mode)
+ * @param [in]        - Pool: Pointer to the pool
+ * @param [in]        - Block: A block taken from this pool
+ * @retval            - MYRTOS_errorID: Pool_Invalid_Block
+ * Note               - For the services freeing blocks (MYRTOS_SVC_PoolFree, mails)
+ */
+
+MYRTOS_errorID MYRTOS_Pool_Put(MYRTOS_Pool_t* Pool, void* Block)
+{
+	uint8_t* P_Block = (uint8_t*)Block;
+	uintptr_t Offset = (uintptr_t)(P_Block - Pool->P_Storage);
+
+	// Not a block of this pool
+	if((P_Block < Pool->P_Storage) || (Offset >= (Pool->BlockSize * Pool->BlocksNum)) || ((Offset % Pool->BlockSize) != 0))
+		return Pool_Invalid_Block;
+
+	// Handed to the first waiter, it doesn't pass through the free list
+	if(MYRTOS_WaitList_Wake(&Pool->P_Waiters, (uintptr_t)P_Block) != NULL)
+		return NO_ERROR;
+
+	*(void**)P_Block = Pool->P_FreeList;
+	Pool->P_FreeList = P_Block;
+	Pool->FreeBlocksNum++;
+
+	return NO_ERROR;
+}
+
+
+
+/**================================================================
+ * @Fn                - MYRTOS_Pool_Alloc
+ * @brief             - Takes a block from a pool
+ * @param [in]        - Pool: Pointer to the pool
+ * @param [in]        - Timeout: Ticks to wait if the pool is empty (MYRTOS_NO_WAIT, MYRTOS_WAIT_FOREVER)
+ * @retval            - void*: The block (NULL: the pool is empty or the timeout passed)
+ * Note              - O(1). From an interrupt it never waits
+ */
+
+void* MYRTOS_Pool_Alloc(MYRTOS_Pool_t* Pool, uint32_t Timeout)
+{
+	return (void*)OS_SVC_CALL(SVC_PoolAlloc, (uintptr_t)Pool, Timeout, 0, 0);
+}
+
+
+
+/**================================================================
+ * @Fn                - MYRTOS_Pool_Free
+ * @brief             - Gives a block back to its pool
+ * @param [in]        - Pool: Pointer to the pool
+ * @param [in]        - P_Block: A block taken from this pool
+ * @retval            - MYRTOS_errorID: Pool_Invalid_Block if it isn't a block of the pool
+ * Note              - O(1), callable from interrupts. A task waiting for a block takes it at once
+ */
+
+MYRTOS_errorID MYRTOS_Pool_Free(MYRTOS_Pool_t* Pool, void* P_Block)
+{
+	return MYRTOS_SVC(SVC_PoolFree, Pool, P_Block);
+}
+
+
+
+/**================================================================
+ * @Fn                - MYRTOS_Pool_Get_FreeBlocks
+ * @brief             - Number of free blocks in a pool
+ * @param [in]        - Pool: Pointer to the pool
+ * @retval            - uint32_t: Free blocks now (Pool->MinFreeBlocksNum: the least so far)
+ * Note              - None
+ */
+
+uint32_t MYRTOS_Pool_Get_FreeBlocks(MYRTOS_Pool_t* Pool)
+{
+	return Pool->FreeBlocksNum;
+}
+
+#endif
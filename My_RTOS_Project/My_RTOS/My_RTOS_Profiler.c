@@ -0,0 +1,92 @@
+/*
+ * My_RTOS_Profiler.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Abdallah
+ */
+
+#include "Schedular.h"
+#include "My_RTOS_Profiler.h"
+
+#include "string.h"
+
+
+#if MYRTOS_USE_PROFILER
+
+MYRTOS_Profile_t MYRTOS_Profile;
+
+
+// Fibonacci hashing of the (PC, task) pair, the high half is the best mixed
+#define PROFILE_HASH(PC, Task)				((((PC) ^ ((Task) << 7)) * 2654435761UL) >> 16)
+
+
+
+/**================================================================
+ * @Fn                - MYRTOS_Profiler_Init
+ * @brief             - Fills the header of the profile and empties the table
+ * @retval            - None
+ * Note              - Called by MYRTOS_Init, call it again to start a new profile (not while the ticker runs)
+ */
+
+void MYRTOS_Profiler_Init()
+{
+	memset(&MYRTOS_Profile, 0, sizeof(MYRTOS_Profile));
+
+	MYRTOS_Profile.Version = MYRTOS_PROFILE_VERSION;
+	MYRTOS_Profile.SlotSize = sizeof(MYRTOS_ProfileSlot_t);
+	MYRTOS_Profile.SlotsNum = MYRTOS_PROFILER_SLOTS;
+
+	// Written last, a dump with the magic has a valid header
+	MYRTOS_Profile.Magic = MYRTOS_PROFILE_MAGIC;
+}
+
+
+
+/**================================================================
+ * @Fn                - MYRTOS_Profiler_Sample
+ * @brief             - Counts one sample of the interrupted code
+ * @param [in]        - PC: The stacked PC of the interrupted code
+ * @param [in]        - InHandler: 1 if the tick interrupted a handler (the kernel or an interrupt), not the task
+ * @param [in]        - TicksNum: Weight of the sample (ticks of the period, more than one after tickless idle)
+ * @retval            - None
+ * Note              - Called by the tick (SysTick_Handler), open addressing with linear probing
+ */
+
+// (Handler Mode)
+void MYRTOS_Profiler_Sample(uint32_t PC, uint8_t InHandler, uint32_t TicksNum)
+{
+	uint32_t Task = (uint32_t)(uintptr_t)MYRTOS_Get_CurrentTask();
+	uint32_t Index, i;
+	MYRTOS_ProfileSlot_t* P_Slot;
+
+	if(InHandler)
+		Task |= MYRTOS_PROFILE_IN_HANDLER;
+
+	MYRTOS_Profile.Samples += TicksNum;
+
+	Index = PROFILE_HASH(PC, Task);
+
+	for(i=0 ; i<MYRTOS_PROFILER_SLOTS ; i++)
+	{
+		P_Slot = &MYRTOS_Profile.Slots[(Index + i) & (MYRTOS_PROFILER_SLOTS - 1)];
+
+		if(P_Slot->Count == 0)
+		{
+			P_Slot->PC = PC;
+			P_Slot->Task = Task;
+			P_Slot->Count = TicksNum;
+			return;
+		}
+
+		if((P_Slot->PC == PC) && (P_Slot->Task == Task))
+		{
+			P_Slot->Count += TicksNum;
+			return;
+		}
+	}
+
+	// The table is full (enlarge MYRTOS_PROFILER_SLOTS)
+	MYRTOS_Profile.Dropped += TicksNum;
+}
+
+#endif
@@ -0,0 +1,135 @@
+/*
+ * My_RTOS_Queue.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Abdallah
+ */
+
+#include "Schedular.h"
+#include "Schedular_Private.h"
+#include "My_RTOS_Queue.h"
+
+#include "string.h"
+
+
+#if MYRTOS_USE_QUEUE
+
+/**================================================================
+ * @Fn                - MYRTOS_Queue_Init
+ * @brief             - Initializes an empty queue on its storage
+ * @param [in]        - Queue: Pointer to the queue
+ * @param [in]        - Storage: MsgSize * Length bytes (MYRTOS_QUEUE_STORAGE)
+ * @param [in]        - MsgSize: Bytes of a message
+ * @param [in]        - Length: Number of messages (a power of two)
+ * @retval            - MYRTOS_errorID: Queue_Invalid_Config
+ * Note              - Call it before any task or interrupt uses the queue
+ */
+
+MYRTOS_errorID MYRTOS_Queue_Init(MYRTOS_Queue_t* Queue, void* Storage, uint32_t MsgSize, uint32_t Length)
+{
+	if(FIFO_Init(&Queue->Messages, Storage, MsgSize, Length) != FIFO_No_Error)
+		return Queue_Invalid_Config;
+
+	Queue->P_Receivers = NULL;
+	Queue->P_Senders = NULL;
+
+	return NO_ERROR;
+}
+
+
+
+/**================================================================
+ * @Fn                - MYRTOS_SVC_QueueSend
+ * @brief             - Message queue services (Handler Mode), called through SVC_Table
+ * @param [in]        - Args: Stacked r0-r3 of the caller (Args[0]: the queue, Args[1]: the message, Args[2]: Timeout)
+ * @retval            - MYRTOS_errorID, written back to the stacked r0
+ * Note               - A task blocked here keeps its message pointer in its stacked r1, the service
+ *                      waking it copies the message from or to there
+ */
+
+uintptr_t MYRTOS_SVC_QueueSend(uintptr_t* Args)
+{
+	MYRTOS_Queue_t* Queue = (MYRTOS_Queue_t*)Args[0];
+	Task_Config* P_Receiver = Queue->P_Receivers;
+
+	// A receiver waits only while the queue is empty: the message goes to its buffer
+	if(P_Receiver != NULL)
+	{
+		memcpy((void*)P_Receiver->Object_Waiting.P_Args[1], (const void*)Args[1], Queue->Messages.element_size);
+		MYRTOS_WaitList_Wake(&Queue->P_Receivers, NO_ERROR);
+
+		return NO_ERROR;
+	}
+
+	if(FIFO_Enqeue(&Queue->Messages, (const void*)Args[1]) == FIFO_No_Error)
+		return NO_ERROR;
+
+	// Full: wait for MYRTOS_SVC_QueueReceive to move the message in
+	if(MYRTOS_WaitList_Block(&Queue->P_Senders, Args, (uint32_t)Args[2]))
+		return Timeout_Expired;
+
+	return Queue_Full;
+}
+
+uintptr_t MYRTOS_SVC_QueueReceive(uintptr_t* Args)
+{
+	MYRTOS_Queue_t* Queue = (MYRTOS_Queue_t*)Args[0];
+	Task_Config* P_Sender;
+
+	if(FIFO_Deqeue(&Queue->Messages, (void*)Args[1]) == FIFO_No_Error)
+	{
+		// The place taken goes to the first waiting sender (its message is after all the others)
+		P_Sender = Queue->P_Senders;
+		if(P_Sender != NULL)
+		{
+			FIFO_Enqeue(&Queue->Messages, (const void*)P_Sender->Object_Waiting.P_Args[1]);
+			MYRTOS_WaitList_Wake(&Queue->P_Senders, NO_ERROR);
+		}
+
+		return NO_ERROR;
+	}
+
+	// Empty: wait for MYRTOS_SVC_QueueSend to copy a message to Args[1]
+	if(MYRTOS_WaitList_Block(&Queue->P_Receivers, Args, (uint32_t)Args[2]))
+		return Timeout_Expired;
+
+	return Queue_Empty;
+}
+
+
+
+/**================================================================
+ * @Fn                - MYRTOS_Queue_Send
+ * @brief             - Copies a message to the end of a queue
+ * @param [in]        - Queue: Pointer to the queue
+ * @param [in]        - Msg: Pointer to the message (MsgSize bytes)
+ * @param [in]        - Timeout: Ticks to wait if the queue is full (MYRTOS_NO_WAIT, MYRTOS_WAIT_FOREVER)
+ * @retval            - MYRTOS_errorID: Queue_Full (it can't wait), Timeout_Expired
+ * Note              - From an interrupt it never waits. The highest priority receiver waiting
+ *                     gets the message at once
+ */
+
+MYRTOS_errorID MYRTOS_Queue_Send(MYRTOS_Queue_t* Queue, const void* Msg, uint32_t Timeout)
+{
+	return (MYRTOS_errorID)OS_SVC_CALL(SVC_QueueSend, (uintptr_t)Queue, (uintptr_t)Msg, Timeout, 0);
+}
+
+
+
+/**================================================================
+ * @Fn                - MYRTOS_Queue_Receive
+ * @brief             - Copies the oldest message out of a queue
+ * @param [in]        - Queue: Pointer to the queue
+ * @param [out]       - Msg: Pointer to store the message (MsgSize bytes)
+ * @param [in]        - Timeout: Ticks to wait if the queue is empty (MYRTOS_NO_WAIT, MYRTOS_WAIT_FOREVER)
+ * @retval            - MYRTOS_errorID: Queue_Empty (it can't wait), Timeout_Expired
+ * Note              - From an interrupt it never waits. Msg must stay valid while the task waits
+ *                     (a sender writes it directly)
+ */
+
+MYRTOS_errorID MYRTOS_Queue_Receive(MYRTOS_Queue_t* Queue, void* Msg, uint32_t Timeout)
+{
+	return (MYRTOS_errorID)OS_SVC_CALL(SVC_QueueReceive, (uintptr_t)Queue, (uintptr_t)Msg, Timeout, 0);
+}
+
+#endif
@@ -0,0 +1,151 @@
+/*
+ * My_RTOS_Ring.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Abdallah
+ */
+
+#include "Schedular.h"
+#include "Schedular_Private.h"
+#include "My_RTOS_Ring.h"
+
+#include "string.h"
+
+
+#if MYRTOS_USE_RING
+
+// Address of the element at (free running) index
+#define RING_ELEMENT(Ring, Index)			((Ring)->base + (((Index) & (Ring)->mask) * (Ring)->element_size))
+
+
+
+/**================================================================
+ * @Fn                - MYRTOS_Ring_Init
+ * @brief             - Initializes an empty ring on a buffer
+ * @param [in]        - Ring: Pointer to the ring
+ * @param [in]        - Buffer: length * element_size bytes (FIFO_BUFFER can declare it)
+ * @param [in]        - element_size: Bytes of an element
+ * @param [in]        - length: Number of elements (a power of two)
+ * @retval            - MYRTOS_errorID: Ring_Invalid_Config
+ * Note              - Call it before the producer and the consumer use the ring
+ */
+
+MYRTOS_errorID MYRTOS_Ring_Init(MYRTOS_Ring_t* Ring, void* Buffer, uint32_t element_size, uint32_t length)
+{
+	if((Buffer == NULL) || (element_size == 0) || (length == 0) || ((length & (length - 1)) != 0))
+		return Ring_Invalid_Config;
+
+	Ring->base = (uint8_t*)Buffer;
+	Ring->element_size = element_size;
+	Ring->mask = length - 1;
+	Ring->head = 0;
+	Ring->tail = 0;
+	Ring->P_Consumer = NULL;
+
+	return NO_ERROR;
+}
+
+
+
+/**================================================================
+ * @Fn                - MYRTOS_SVC_RingWait
+ * @brief             - Ring services (Handler Mode), called through SVC_Table
+ * @param [in]        - Args: Stacked r0-r3 of the caller (Args[0]: the ring)
+ * @retval            - MYRTOS_errorID, written back to the stacked r0
+ * Note               - The producer interrupt can't run in the kernel, so a push is either seen here
+ *                      or sees the consumer sleeping (no wake up is lost)
+ */
+
+// Args[1]: Timeout
+uintptr_t MYRTOS_SVC_RingWait(uintptr_t* Args)
+{
+	MYRTOS_Ring_t* Ring = (MYRTOS_Ring_t*)Args[0];
+
+	// Pushed since the consumer found it empty
+	if(Ring->head != Ring->tail)
+		return NO_ERROR;
+
+	if(MYRTOS_WaitList_Block(&Ring->P_Consumer, Args, (uint32_t)Args[1]))
+		return Timeout_Expired;
+
+	return Ring_Empty;
+}
+
+uintptr_t MYRTOS_SVC_RingWake(uintptr_t* Args)
+{
+	MYRTOS_Ring_t* Ring = (MYRTOS_Ring_t*)Args[0];
+
+	MYRTOS_WaitList_Wake(&Ring->P_Consumer, NO_ERROR);
+
+	return NO_ERROR;
+}
+
+
+
+/**================================================================
+ * @Fn                - MYRTOS_Ring_Push
+ * @brief             - Copies an element to the ring (the producer)
+ * @param [in]        - Ring: Pointer to the ring
+ * @param [in]        - Item: Pointer to the element (element_size bytes)
+ * @retval            - MYRTOS_errorID: Ring_Full
+ * Note              - Lock-free, from an interrupt or a task. The kernel is entered only to wake
+ *                     a consumer sleeping in MYRTOS_Ring_Pop
+ */
+
+MYRTOS_errorID MYRTOS_Ring_Push(MYRTOS_Ring_t* Ring, const void* Item)
+{
+	uint32_t Tail = Ring->tail;
+
+	if((Tail - Ring->head) > Ring->mask)
+		return Ring_Full;
+
+	memcpy(RING_ELEMENT(Ring, Tail), Item, Ring->element_size);
+
+	// The element is written before the consumer can see it
+	OS_MEMORY_BARRIER();
+	Ring->tail = Tail + 1;
+
+	if(*(struct Task_Config* volatile*)&Ring->P_Consumer != NULL)
+		MYRTOS_SVC(SVC_RingWake, Ring, 0);
+
+	return NO_ERROR;
+}
+
+
+
+/**================================================================
+ * @Fn                - MYRTOS_Ring_Pop
+ * @brief             - Copies the oldest element out of the ring (the consumer)
+ * @param [in]        - Ring: Pointer to the ring
+ * @param [out]       - Item: Pointer to store the element (element_size bytes)
+ * @param [in]        - Timeout: Ticks to sleep if the ring is empty (MYRTOS_NO_WAIT, MYRTOS_WAIT_FOREVER)
+ * @retval            - MYRTOS_errorID: Ring_Empty (MYRTOS_NO_WAIT), Timeout_Expired
+ * Note              - Lock-free while the ring has elements, only sleeping enters the kernel.
+ *                     The timeout starts again if the consumer is woken without an element
+ */
+
+MYRTOS_errorID MYRTOS_Ring_Pop(MYRTOS_Ring_t* Ring, void* Item, uint32_t Timeout)
+{
+	uint32_t Head = Ring->head;
+	MYRTOS_errorID ErrorState;
+
+	while(Head == Ring->tail)
+	{
+		if(Timeout == MYRTOS_NO_WAIT)
+			return Ring_Empty;
+
+		ErrorState = MYRTOS_SVC(SVC_RingWait, Ring, Timeout);
+		if(ErrorState != NO_ERROR)
+			return ErrorState;
+	}
+
+	// The element is read after its tail, and before its place is given back to the producer
+	OS_MEMORY_BARRIER();
+	memcpy(Item, RING_ELEMENT(Ring, Head), Ring->element_size);
+	OS_MEMORY_BARRIER();
+	Ring->head = Head + 1;
+
+	return NO_ERROR;
+}
+
+#endif
@@ -0,0 +1,114 @@
+/*
+ * My_RTOS_Semaphore.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Abdallah
+ */
+
+#include "Schedular.h"
+#include "Schedular_Private.h"
+#include "My_RTOS_Semaphore.h"
+
+#include "stddef.h"
+
+
+#if MYRTOS_USE_SEMAPHORE
+
+/**================================================================
+ * @Fn                - MYRTOS_Semaphore_Init
+ * @brief             - Initializes a semaphore
+ * @param [in]        - Semaphore: Pointer to the semaphore
+ * @param [in]        - InitialCount: Counts available at first (0: the first take waits for a give)
+ * @param [in]        - MaxCount: Counts at most (1: binary semaphore)
+ * @retval            - MYRTOS_errorID: Semaphore_Invalid_Config
+ * Note              - Call it before any task or interrupt uses the semaphore
+ */
+
+MYRTOS_errorID MYRTOS_Semaphore_Init(MYRTOS_Semaphore_t* Semaphore, uint32_t InitialCount, uint32_t MaxCount)
+{
+	if((MaxCount == 0) || (InitialCount > MaxCount))
+		return Semaphore_Invalid_Config;
+
+	Semaphore->Count = InitialCount;
+	Semaphore->MaxCount = MaxCount;
+	Semaphore->P_Waiters = NULL;
+
+	return NO_ERROR;
+}
+
+
+
+/**================================================================
+ * @Fn                - MYRTOS_SVC_SemaphoreTake
+ * @brief             - Semaphore services (Handler Mode), called through SVC_Table
+ * @param [in]        - Args: Stacked r0-r3 of the caller (Args[0]: the semaphore)
+ * @retval            - MYRTOS_errorID, written back to the stacked r0
+ * Note               - None
+ */
+
+// Args[1]: Timeout
+uintptr_t MYRTOS_SVC_SemaphoreTake(uintptr_t* Args)
+{
+	MYRTOS_Semaphore_t* Semaphore = (MYRTOS_Semaphore_t*)Args[0];
+
+	if(Semaphore->Count != 0)
+	{
+		Semaphore->Count--;
+		return NO_ERROR;
+	}
+
+	// MYRTOS_SVC_SemaphoreGive writes NO_ERROR to the stacked r0 of the task
+	if(MYRTOS_WaitList_Block(&Semaphore->P_Waiters, Args, (uint32_t)Args[1]))
+		return Timeout_Expired;
+
+	return Semaphore_Unavailable;
+}
+
+uintptr_t MYRTOS_SVC_SemaphoreGive(uintptr_t* Args)
+{
+	MYRTOS_Semaphore_t* Semaphore = (MYRTOS_Semaphore_t*)Args[0];
+
+	// The count goes to the first waiter, it isn't added
+	if(MYRTOS_WaitList_Wake(&Semaphore->P_Waiters, NO_ERROR) != NULL)
+		return NO_ERROR;
+
+	if(Semaphore->Count >= Semaphore->MaxCount)
+		return Semaphore_Overflow;
+
+	Semaphore->Count++;
+
+	return NO_ERROR;
+}
+
+
+
+/**================================================================
+ * @Fn                - MYRTOS_Semaphore_Take
+ * @brief             - Takes a count of a semaphore
+ * @param [in]        - Semaphore: Pointer to the semaphore
+ * @param [in]        - Timeout: Ticks to wait if no count is available (MYRTOS_NO_WAIT, MYRTOS_WAIT_FOREVER)
+ * @retval            - MYRTOS_errorID: Semaphore_Unavailable (it can't wait), Timeout_Expired
+ * Note              - From an interrupt it never waits
+ */
+
+MYRTOS_errorID MYRTOS_Semaphore_Take(MYRTOS_Semaphore_t* Semaphore, uint32_t Timeout)
+{
+	return MYRTOS_SVC(SVC_SemaphoreTake, Semaphore, Timeout);
+}
+
+
+
+/**================================================================
+ * @Fn                - MYRTOS_Semaphore_Give
+ * @brief             - Gives a count to a semaphore
+ * @param [in]        - Semaphore: Pointer to the semaphore
+ * @retval            - MYRTOS_errorID: Semaphore_Overflow (already MaxCount, the give is lost)
+ * Note              - Callable from interrupts. The highest priority waiter takes the count
+ */
+
+MYRTOS_errorID MYRTOS_Semaphore_Give(MYRTOS_Semaphore_t* Semaphore)
+{
+	return MYRTOS_SVC(SVC_SemaphoreGive, Semaphore, 0);
+}
+
+#endif
@@ -0,0 +1,108 @@
+/*
+ * My_RTOS_Trace.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Abdallah
+ */
+
+#include "Schedular.h"
+#include "My_RTOS_Trace.h"
+
+#include "string.h"
+
+
+#if MYRTOS_USE_TRACE
+
+MYRTOS_TraceBuffer_t MYRTOS_TraceBuffer;
+
+
+
+/**================================================================
+ * @Fn                - MYRTOS_Trace_Init
+ * @brief             - Fills the header of the trace buffer and empties the ring
+ * @retval            - None
+ * Note              - Called by MYRTOS_Init (before creating the idle task)
+ */
+
+void MYRTOS_Trace_Init()
+{
+	memset(&MYRTOS_TraceBuffer, 0, sizeof(MYRTOS_TraceBuffer));
+
+	MYRTOS_TraceBuffer.Version = MYRTOS_TRACE_VERSION;
+	MYRTOS_TraceBuffer.RecordSize = sizeof(MYRTOS_TraceRecord_t);
+	MYRTOS_TraceBuffer.RecordsNum = MYRTOS_TRACE_RECORDS;
+	MYRTOS_TraceBuffer.CyclesPerUs = OS_CYCLES_PER_US;
+	MYRTOS_TraceBuffer.MaxTasks = MYRTOS_MAX_TASKS;
+
+	// Written last, a dump with the magic has a valid header
+	MYRTOS_TraceBuffer.Magic = MYRTOS_TRACE_MAGIC;
+}
+
+
+
+/**================================================================
+ * @Fn                - MYRTOS_Trace_TaskCreated
+ * @brief             - Gives the task its trace ID and keeps its name in the trace buffer
+ * @param [in]        - taskReference: Pointer to the task configuration structure
+ * @retval            - None
+ * Note              - Called by MYRTOS_Create_Task, the decoder names the tasks from the buffer alone
+ */
+
+void MYRTOS_Trace_TaskCreated(Task_Config* taskReference)
+{
+	// Deleted tasks keep their IDs, the tasks created after the ID MYRTOS_TRACE_NO_TASK - 1 share it
+	taskReference->TraceID = (uint8_t)MYRTOS_TraceBuffer.TasksNum;
+	if(MYRTOS_TraceBuffer.TasksNum < (MYRTOS_TRACE_NO_TASK - 1))
+		MYRTOS_TraceBuffer.TasksNum++;
+
+#if MYRTOS_USE_TASK_NAMES
+	// Names of the first MYRTOS_MAX_TASKS tasks created, truncated to MYRTOS_TRACE_NAME_LENGTH - 1 characters
+	// (the buffer is zeroed by MYRTOS_Trace_Init)
+	if(taskReference->TraceID < MYRTOS_MAX_TASKS)
+	{
+		for(uint32_t i=0 ; (i < (MYRTOS_TRACE_NAME_LENGTH - 1)) && (taskReference->TaskName[i] != '\0') ; i++)
+			MYRTOS_TraceBuffer.TaskNames[taskReference->TraceID][i] = taskReference->TaskName[i];
+	}
+#endif
+}
+
+
+
+/**================================================================
+ * @Fn                - MYRTOS_Trace_Record
+ * @brief             - Appends one record to the ring (the oldest record is overwritten when it is full)
+ * @param [in]        - Event: MYRTOS_TraceEvent_t
+ * @param [in]        - TaskID: Trace ID of the task of the event (MYRTOS_TRACE_NO_TASK if none)
+ * @param [in]        - Arg: Depends on the event
+ * @retval            - None
+ * Note              - Handler mode only (the cycle counter isn't accessible to unprivileged tasks),
+ * 					   the slot is taken atomically, so interrupts can record over the kernel
+ */
+
+void MYRTOS_Trace_Record(uint8_t Event, uint8_t TaskID, uint16_t Arg)
+{
+	uint32_t Index = __atomic_fetch_add(&MYRTOS_TraceBuffer.Head, 1, __ATOMIC_RELAXED);
+	MYRTOS_TraceRecord_t* P_Record = &MYRTOS_TraceBuffer.Records[Index & (MYRTOS_TRACE_RECORDS - 1)];
+
+	P_Record->Timestamp = OS_GET_CYCLES();
+	P_Record->TaskID = TaskID;
+	P_Record->Arg = Arg;
+	P_Record->Event = Event;
+}
+
+
+
+/**================================================================
+ * @Fn                - MYRTOS_Trace_ISR
+ * @brief             - Records the entry or the exit of the running interrupt handler
+ * @param [in]        - Event: MYRTOS_TRACE_ISR_ENTER or MYRTOS_TRACE_ISR_EXIT
+ * @retval            - None
+ * Note              - Use MYRTOS_TRACE_ISR_ENTER() / MYRTOS_TRACE_ISR_EXIT()
+ */
+
+void MYRTOS_Trace_ISR(uint8_t Event)
+{
+	MYRTOS_Trace_Record(Event, MYRTOS_TRACE_NO_TASK, OS_GET_IRQ_NUMBER());
+}
+
+#endif
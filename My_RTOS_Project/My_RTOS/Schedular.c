@@ -7,29 +7,43 @@
 
 
 #include "Schedular.h"
-#include "My_RTOS_FIFO.h"
 
 #include "string.h"
+#include "stddef.h"
 #include "Schedular_Private.h"
+#include "My_RTOS_Trace.h"
+#include "My_RTOS_Profiler.h"
 
 
 
-FIFO_Buffer_t ReadyQueue;
-Task_Config *ReadyQueueFIFO[100];
-
 Task_Config MYRTOS_IdleTask;
 
 
 // OS states (in .c not .h to not being seen by the user)
 
 struct{
-	Task_Config* OS_Tasks[100];  // Tasks(schedular) table (Can hold up to 100 tasks)
+	Task_Config* CurrentTaskExecuted;    // First two members, used by PendSV_Handler
+	Task_Config* NextTaskTobeExecuted;
+	Task_Config* OS_Tasks[MYRTOS_MAX_TASKS];  // Tasks(schedular) table (Can hold up to MYRTOS_MAX_TASKS tasks)
+	Task_Config* ReadyList[MYRTOS_MAX_PRIORITIES];  // Circular list of ready tasks for each priority (head runs first)
+	uint32_t ReadyPriorityBitmap;    // Bit (31 - priority) is set while ReadyList[priority] isn't empty
+#if MYRTOS_USE_TIMING_WAIT
+	Task_Config* WaitingList;        // Tasks blocked based on time (delta list, head wakes first)
+#endif
+	uint8_t ReadyChanged;            // A ready list changed since the last Decide_WhatNextTask (a service reschedules)
+	uint32_t SystemTicks;            // Ticks since the OS started
 	uint32_t _S_MSP;   // Pointed to the start of the SRAM (From startup)
 	uint32_t _E_MSP;   // Then this will act as the size of the stack
 	uint32_t PSP_Task_Locator;
+#if MYRTOS_USE_TASK_DELETE
+	uint32_t FreeStacks[MYRTOS_STACK_CLASSES + 1];   // Stacks of deleted tasks (their _S_PSP_Task) by size class, 0: empty
+#endif
 	uint32_t ActiveTasksNum;
-	Task_Config* CurrentTaskExecuted;
-	Task_Config* NextTaskTobeExecuted;
+#if MYRTOS_USE_STATISTICS
+	uint32_t LastSwitchCycles;       // Cycle counter when the current task was last accounted
+	volatile uint32_t AccountsNum;   // Changes on every accounting (consistent reads from thread mode)
+	uint64_t TotalCycles;            // Cycles accounted to all tasks
+#endif
 	enum{
 		OS_Suspend,
 		OS_Running
@@ -37,312 +51,919 @@ struct{
 }OS_Control;
 
 
+// PendSV_Handler (assembly) relies on these offsets
+_Static_assert(offsetof(__typeof__(OS_Control), CurrentTaskExecuted) == 0, "PendSV_Handler: CurrentTaskExecuted offset");
+_Static_assert(offsetof(__typeof__(OS_Control), NextTaskTobeExecuted) == sizeof(Task_Config*), "PendSV_Handler: NextTaskTobeExecuted offset");
+_Static_assert(offsetof(Task_Config, Current_PSP) == 0, "PendSV_Handler: Current_PSP offset");
+#if MYRTOS_USE_STACK_CHECK && !defined(MYRTOS_PORT_LINUX)
+_Static_assert(offsetof(Task_Config, _E_PSP_Task) == MYRTOS_TASK_E_PSP_OFFSET, "PendSV_Handler: _E_PSP_Task offset");
+#endif
+
+
+// Priority 0 takes the MSB, so CLZ of the bitmap gives the highest ready priority directly
+#define READY_PRIORITY_BIT(Priority)		(0x80000000UL >> (Priority))
+
+// The task is in the scheduler table (created, not deleted), O(1) by its place in the table
+#define TASK_IS_CREATED(P_Task)				(((P_Task)->TableIndex < OS_Control.ActiveTasksNum) && \
+											 (OS_Control.OS_Tasks[(P_Task)->TableIndex] == (P_Task)))
+
+
+#if MYRTOS_USE_TASK_DELETE
+#if (MYRTOS_STACK_GRANULE % 8) != 0
+#error "MYRTOS_STACK_GRANULE must be a multiple of 8"
+#endif
+
+// Stack given to a task: a whole number of granules (one at least)
+#define STACK_POOL_SIZE(Stack_Size)			(((Stack_Size) ? (((Stack_Size) + MYRTOS_STACK_GRANULE - 1) / MYRTOS_STACK_GRANULE) : 1) * MYRTOS_STACK_GRANULE)
+// Free list of a stack size (the last one holds all the larger stacks)
+#define STACK_POOL_CLASS(Size)				(((Size) / MYRTOS_STACK_GRANULE <= MYRTOS_STACK_CLASSES) ? ((Size) / MYRTOS_STACK_GRANULE - 1) : MYRTOS_STACK_CLASSES)
+
+// A free stack keeps the next free stack of its list and its size in its top two words
+#define FREE_STACK_NEXT(Top)				(((uint32_t*)(uintptr_t)(Top))[-1])
+#define FREE_STACK_SIZE(Top)				(((uint32_t*)(uintptr_t)(Top))[-2])
+#endif
 
-typedef enum{
-	SVC_ActivateTask,
-	SVC_TerminateTask,
-	SVC_TaskWaitingTime,
-	SVC_AcquireMutex,
-	SVC_ReleaseMutex
-}SVC_ID;
 
 
 /**================================================================
- * @Fn                - BubbleSort_SchedularTable
- * @brief             - Sorts the scheduler table using Bubble Sort
- * @param [in]        - schedTable: Pointer to the scheduler table to be sorted
- * @param [in]        - tableSize: Number of elements in the scheduler table
+ * @Fn                - MYRTOS_ReadyList_Insert
+ * @brief             - Appends a task to the tail of the ready list of its priority
+ * @param [in]        - taskReference: Pointer to the task configuration structure
  * @retval            - None
- * Note              - This function modifies the order of tasks in the scheduler table.
+ * Note              - O(1), a task already in the ready list is left in its place
  */
 
-
 // (Handler Mode)
-void BubbleSort_SchedularTable()
+void MYRTOS_ReadyList_Insert(Task_Config* taskReference)
 {
-	unsigned int i ,j ,n;
-	Task_Config* TempTask;
+	Task_Config* P_Head;
 
-	n = OS_Control.ActiveTasksNum;
+	// Already ready (or running)
+	if(taskReference->P_NextReadyTask != NULL)
+		return;
 
-	for(i=0 ; i < n - 1 ; i++)
+	P_Head = OS_Control.ReadyList[taskReference->Priority];
+
+	if(P_Head == NULL)
 	{
-		for(j=0 ; j < n - i - 1 ; j++)
-		{
-			// Higher priority first
-			if(OS_Control.OS_Tasks[j]->Priority > OS_Control.OS_Tasks[j+1]->Priority)
-			{
-				TempTask = OS_Control.OS_Tasks[j];
-				OS_Control.OS_Tasks[j] = OS_Control.OS_Tasks[j+1];
-				OS_Control.OS_Tasks[j+1] = TempTask;
-			}
-		}
+		// First ready task in this priority
+		taskReference->P_NextReadyTask = taskReference;
+		taskReference->P_PrevReadyTask = taskReference;
+		OS_Control.ReadyList[taskReference->Priority] = taskReference;
+		OS_Control.ReadyPriorityBitmap |= READY_PRIORITY_BIT(taskReference->Priority);
+	}else{
+		// The tail is the one before the head (circular list)
+		taskReference->P_NextReadyTask = P_Head;
+		taskReference->P_PrevReadyTask = P_Head->P_PrevReadyTask;
+		P_Head->P_PrevReadyTask->P_NextReadyTask = taskReference;
+		P_Head->P_PrevReadyTask = taskReference;
 	}
+
+	OS_Control.ReadyChanged = 1;
+
+	if(taskReference->Task_State != Running)
+		taskReference->Task_State = Ready;
 }
 
 
 
 /**================================================================
- * @Fn                - MYRTOS_Update_SchedulerTable
- * @brief             - Updates the scheduler table for the MYRTOS
- * @param [in]        - None
- * @param [in]        - None
+ * @Fn                - MYRTOS_ReadyList_Remove
+ * @brief             - Removes a task from the ready list of its priority
+ * @param [in]        - taskReference: Pointer to the task configuration structure
  * @retval            - None
- * Note              - This function is called via svc handler
+ * Note              - O(1), the task state itself is updated by the caller
  */
 
 // (Handler Mode)
-void MYRTOS_Update_SchedulerTable()
+void MYRTOS_ReadyList_Remove(Task_Config* taskReference)
 {
-	Task_Config* TempTaskDequeue = NULL;
-	Task_Config *P_Task = NULL ,*P_nextTask = NULL;
-	int i = 0;
+	// Not in the ready list
+	if(taskReference->P_NextReadyTask == NULL)
+		return;
+
+	if(taskReference->P_NextReadyTask == taskReference)
+	{
+		// The only one in this priority
+		OS_Control.ReadyList[taskReference->Priority] = NULL;
+		OS_Control.ReadyPriorityBitmap &= ~READY_PRIORITY_BIT(taskReference->Priority);
+	}else{
+		taskReference->P_PrevReadyTask->P_NextReadyTask = taskReference->P_NextReadyTask;
+		taskReference->P_NextReadyTask->P_PrevReadyTask = taskReference->P_PrevReadyTask;
 
-	// Update Scheduler table
+		if(OS_Control.ReadyList[taskReference->Priority] == taskReference)
+			OS_Control.ReadyList[taskReference->Priority] = taskReference->P_NextReadyTask;
+	}
+
+	taskReference->P_NextReadyTask = NULL;
+	taskReference->P_PrevReadyTask = NULL;
+
+	OS_Control.ReadyChanged = 1;
+}
 
-	// 1- Bubble Sort Sch_Table in OS_Control --> OS_Tasks[100]
-	//    based on priority (high then low)
-	BubbleSort_SchedularTable();
 
-	// 2- Free Ready Queue
-	while(FIFO_Deqeue(&ReadyQueue, &TempTaskDequeue /*Pointer to pointer*/) != FIFO_Empty);
 
+#if MYRTOS_USE_TIMING_WAIT
+
+/**================================================================
+ * @Fn                - MYRTOS_WaitingList_Insert
+ * @brief             - Inserts a task blocked based on time into the waiting list
+ * @param [in]        - taskReference: Pointer to the task configuration structure (Ticks_Count = ticks to wait)
+ * @retval            - None
+ * Note              - The list is sorted by wake up time, each task holds its ticks after the previous one,
+ *                     so the tick only decrements the head
+ */
 
-	// 3- Update Ready Queue
-	while(i<OS_Control.ActiveTasksNum)
+// (Handler Mode)
+void MYRTOS_WaitingList_Insert(Task_Config* taskReference)
+{
+	Task_Config *P_Prev = NULL, *P_Next = OS_Control.WaitingList;
+	uint32_t Ticks = taskReference->Time_Waiting.Ticks_Count;
+
+	// Skip the tasks waking before it (or at the same tick)
+	while((P_Next != NULL) && (P_Next->Time_Waiting.Ticks_Count <= Ticks))
 	{
-		P_Task = OS_Control.OS_Tasks[i];
-		P_nextTask = OS_Control.OS_Tasks[i+1];
-
-		if(P_Task->Task_State != Suspend){
-
-			// If we reached the end of the available Tasks
-			// Then add the last one to the ready Queue and update its state
-			// Because if we assumed its priority = 7, then the next one would be empty which is suspend(0) by default
-			// Then we can't rely on the comparison of priority only
-
-			if(P_nextTask->Task_State == Suspend)
-			{
-				FIFO_Enqeue(&ReadyQueue, P_Task);
-				P_Task->Task_State = Ready;
-				break;
-			}
-
-			// If the task is higher priority than the next one
-			// Then add it to the readyQueue and break
-
-			if(P_Task->Priority < P_nextTask->Priority)
-			{
-				FIFO_Enqeue(&ReadyQueue, P_Task);
-				P_Task->Task_State = Ready;
-				break;
-			}else if(P_Task->Priority == P_nextTask->Priority)
-			{
-				// In case of same priority (Round robin)
-				// Then push P_Task, and make P_Task = P_nextTask, and P_nextTask++
-				FIFO_Enqeue(&ReadyQueue, P_Task);
-				P_Task->Task_State = Ready;
-			}else{
-				// Bubble Sort failed, can't happen
-				break;
-			}
-		}
+		Ticks -= P_Next->Time_Waiting.Ticks_Count;
+		P_Prev = P_Next;
+		P_Next = P_Next->Time_Waiting.P_NextWaitingTask;
+	}
+
+	taskReference->Time_Waiting.Ticks_Count = Ticks;
+	taskReference->Time_Waiting.P_PrevWaitingTask = P_Prev;
+	taskReference->Time_Waiting.P_NextWaitingTask = P_Next;
 
+	if(P_Prev == NULL)
+		OS_Control.WaitingList = taskReference;
+	else
+		P_Prev->Time_Waiting.P_NextWaitingTask = taskReference;
 
-		i++;
+	if(P_Next != NULL)
+	{
+		// The next task now counts after this one
+		P_Next->Time_Waiting.Ticks_Count -= Ticks;
+		P_Next->Time_Waiting.P_PrevWaitingTask = taskReference;
 	}
 
+	taskReference->Time_Waiting.Block_Timing = Blocking_Enable;
 }
 
 
 
 /**================================================================
- * @Fn                - Decide_WhatNextTask
- * @brief             - Determine current task and next task to be run
- * @param [in]        - None
- * @param [in]        - None
+ * @Fn                - MYRTOS_WaitingList_Remove
+ * @brief             - Removes a task from the waiting list before its time
+ * @param [in]        - taskReference: Pointer to the task configuration structure
  * @retval            - None
- * Note              - None
+ * Note              - O(1), its remaining ticks are given to the next task
  */
 
+// (Handler Mode)
+void MYRTOS_WaitingList_Remove(Task_Config* taskReference)
+{
+	Task_Config *P_Prev, *P_Next;
+
+	if(taskReference->Time_Waiting.Block_Timing != Blocking_Enable)
+		return;
+
+	P_Prev = taskReference->Time_Waiting.P_PrevWaitingTask;
+	P_Next = taskReference->Time_Waiting.P_NextWaitingTask;
+
+	if(P_Prev == NULL)
+		OS_Control.WaitingList = P_Next;
+	else
+		P_Prev->Time_Waiting.P_NextWaitingTask = P_Next;
+
+	if(P_Next != NULL)
+	{
+		P_Next->Time_Waiting.Ticks_Count += taskReference->Time_Waiting.Ticks_Count;
+		P_Next->Time_Waiting.P_PrevWaitingTask = P_Prev;
+	}
+
+	taskReference->Time_Waiting.P_NextWaitingTask = NULL;
+	taskReference->Time_Waiting.P_PrevWaitingTask = NULL;
+	taskReference->Time_Waiting.Block_Timing = Blocking_Disable;
+}
+
+#endif
+
+
+
+/**================================================================
+ * @Fn                - MYRTOS_WaitList_Insert
+ * @brief             - Links a task in a wait list at the place of its priority
+ * @param [in]        - P_WaitList: Wait list of the object
+ * @param [in]        - taskReference: Pointer to the task configuration structure
+ * @retval            - None
+ * Note              - After the waiters of higher or the same priority (FIFO among equals)
+ */
 
 // (Handler Mode)
-void Decide_WhatNextTask()
+void MYRTOS_WaitList_Insert(Task_Config** P_WaitList, Task_Config* taskReference)
 {
-	// If ready Queue && OS_Control->CurrentTask != Suspend
-	// Then make the current task run again till termination
-	if((ReadyQueue.counter == 0) && (OS_Control.CurrentTaskExecuted->Task_State != Suspend))
+	Task_Config *P_Prev = NULL, *P_Next = *P_WaitList;
+
+	while((P_Next != NULL) && (P_Next->Priority <= taskReference->Priority))
 	{
-		OS_Control.CurrentTaskExecuted->Task_State = Running;
-		FIFO_Enqeue(&ReadyQueue, OS_Control.CurrentTaskExecuted);
-		// Make the current task next also, to run it again, if context switch happened
-		OS_Control.NextTaskTobeExecuted = OS_Control.CurrentTaskExecuted;
-	}else{
-		FIFO_Deqeue(&ReadyQueue, &OS_Control.NextTaskTobeExecuted);
-		OS_Control.NextTaskTobeExecuted->Task_State = Running;
-		// Update readyQueue to maintain round robin (if same priority)
-		if((OS_Control.CurrentTaskExecuted->Priority == OS_Control.NextTaskTobeExecuted->Priority) && (OS_Control.CurrentTaskExecuted->Task_State != Suspend))
-		{
-			FIFO_Enqeue(&ReadyQueue, OS_Control.CurrentTaskExecuted);
-			OS_Control.CurrentTaskExecuted->Task_State = Ready;
-		}
+		P_Prev = P_Next;
+		P_Next = P_Next->Object_Waiting.P_NextWaiter;
 	}
+
+	taskReference->Object_Waiting.P_WaitList = P_WaitList;
+	taskReference->Object_Waiting.P_PrevWaiter = P_Prev;
+	taskReference->Object_Waiting.P_NextWaiter = P_Next;
+
+	if(P_Prev == NULL)
+		*P_WaitList = taskReference;
+	else
+		P_Prev->Object_Waiting.P_NextWaiter = taskReference;
+
+	if(P_Next != NULL)
+		P_Next->Object_Waiting.P_PrevWaiter = taskReference;
 }
 
 
 
 /**================================================================
- * @Fn                - OS_SVC_Services
- * @brief             - To execute specific OS service
- * @param [in]        - StackFramePointer: the start of the current stack
- * @param [in]        - None
+ * @Fn                - MYRTOS_WaitList_Block
+ * @brief             - Blocks the current task on a kernel object till it is woken or its timeout passes
+ * @param [in]        - P_WaitList: Wait list of the object
+ * @param [in]        - Args: Stacked r0-r3 of the blocking call (the service returns its timeout result,
+ *                      MYRTOS_WaitList_Wake writes the result to r0 instead)
+ * @param [in]        - Timeout: Ticks to wait (MYRTOS_WAIT_FOREVER: no timeout)
+ * @retval            - uint8_t: 1 if the task blocked, 0 with MYRTOS_NO_WAIT, from an interrupt, before the OS runs
+ *                      or from the idle task (the call can't wait)
+ * Note              - The list is sorted by priority, tasks of the same priority in the order they blocked
+ */
+
+// (Handler Mode)
+uint8_t MYRTOS_WaitList_Block(Task_Config** P_WaitList, uintptr_t* Args, uint32_t Timeout)
+{
+	Task_Config* P_Task = OS_Control.CurrentTaskExecuted;
+
+	if((Timeout == MYRTOS_NO_WAIT) || MYRTOS_CALLED_FROM_ISR(Args) || (OS_Control.OS_Modes_ID != OS_Running) ||
+			(P_Task == &MYRTOS_IdleTask))
+		return 0;
+
+	MYRTOS_ReadyList_Remove(P_Task);
+	P_Task->Task_State = Suspend;
+
+	MYRTOS_WaitList_Insert(P_WaitList, P_Task);
+	P_Task->Object_Waiting.P_Args = Args;
+
+#if MYRTOS_USE_TIMING_WAIT
+	// Woken by MYRTOS_Update_Tasks_WaitingTime if nothing woke it before
+	if(Timeout != MYRTOS_WAIT_FOREVER)
+	{
+		P_Task->Time_Waiting.Ticks_Count = Timeout;
+		MYRTOS_WaitingList_Insert(P_Task);
+	}
+#else
+	(void)Timeout;
+#endif
+
+	return 1;
+}
+
+
+
+/**================================================================
+ * @Fn                - MYRTOS_WaitList_Remove
+ * @brief             - Removes a task from the wait list of the object it is blocked on
+ * @param [in]        - taskReference: Pointer to the task configuration structure
+ * @retval            - None
+ * Note              - O(1), nothing if the task isn't blocked on an object (its timeout, MYRTOS_Delete_Task)
+ */
+
+// (Handler Mode)
+void MYRTOS_WaitList_Remove(Task_Config* taskReference)
+{
+	Task_Config *P_Prev, *P_Next;
+
+	if(taskReference->Object_Waiting.P_WaitList == NULL)
+		return;
+
+	P_Prev = taskReference->Object_Waiting.P_PrevWaiter;
+	P_Next = taskReference->Object_Waiting.P_NextWaiter;
+
+	if(P_Prev == NULL)
+		*taskReference->Object_Waiting.P_WaitList = P_Next;
+	else
+		P_Prev->Object_Waiting.P_NextWaiter = P_Next;
+
+	if(P_Next != NULL)
+		P_Next->Object_Waiting.P_PrevWaiter = P_Prev;
+
+	taskReference->Object_Waiting.P_WaitList = NULL;
+	taskReference->Object_Waiting.P_NextWaiter = NULL;
+	taskReference->Object_Waiting.P_PrevWaiter = NULL;
+}
+
+
+
+/**================================================================
+ * @Fn                - MYRTOS_WaitList_Requeue
+ * @brief             - Moves a blocked task to the place of its new priority in its wait list
+ * @param [in]        - taskReference: Pointer to the task configuration structure
  * @retval            - None
- * Note               - This function mainly gets the SVC_Number passed using svc instruction, and then perform some operations according to that number
+ * Note              - For priority inheritance of a mutex owner blocked on a kernel object (a mutex, a semaphore, ...),
+ *                     nothing if it isn't blocked
  */
 
+// (Handler Mode)
+void MYRTOS_WaitList_Requeue(Task_Config* taskReference)
+{
+	Task_Config** P_WaitList = taskReference->Object_Waiting.P_WaitList;
 
-// To execute specific OS service(Handler Mode)
-void OS_SVC_Services(int* StackFramePointer)
+	if(P_WaitList == NULL)
+		return;
+
+	MYRTOS_WaitList_Remove(taskReference);
+	MYRTOS_WaitList_Insert(P_WaitList, taskReference);
+}
+
+
+
+/**================================================================
+ * @Fn                - MYRTOS_WaitList_Wake
+ * @brief             - Wakes the first task (the highest priority) blocked on a kernel object
+ * @param [in]        - P_WaitList: Wait list of the object
+ * @param [in]        - Result: Returned by the blocking call of the task (written to its stacked r0)
+ * @retval            - Task_Config*: The task woken (NULL: no task was waiting)
+ * Note              - O(1), the caller decides what next (the service returns to OS_SVC_Services)
+ */
+
+// (Handler Mode)
+Task_Config* MYRTOS_WaitList_Wake(Task_Config** P_WaitList, uintptr_t Result)
 {
-	// OS_SVC_Set stack --> r0 = argument 0 = StackFramePointer
-	// OS_SVC_Set stack --> r0,r1,r2,r3,r12,lr,pc,xpsr
+	Task_Config* P_Task = *P_WaitList;
+
+	if(P_Task == NULL)
+		return NULL;
 
-	unsigned char SVC_Number;
+	MYRTOS_WaitList_Remove(P_Task);
+#if MYRTOS_USE_TIMING_WAIT
+	MYRTOS_WaitingList_Remove(P_Task);
+#endif
+
+	P_Task->Object_Waiting.P_Args[0] = Result;
+	MYRTOS_ReadyList_Insert(P_Task);
+
+	return P_Task;
+}
 
-	SVC_Number = *((unsigned char*)(((unsigned char*)StackFramePointer[6]) - 2));
 
 
-	switch(SVC_Number)
+/**================================================================
+ * @Fn                - MYRTOS_ReadyList_Move
+ * @brief             - Moves a task to another priority (priority inheritance / restoring it)
+ * @param [in]        - taskReference: Pointer to the task configuration structure
+ * @param [in]        - Priority: The new priority of the task
+ * @retval            - None
+ * Note              - O(1), a ready (or running) task goes to the tail of the ready list of its new priority
+ */
+
+// (Handler Mode)
+void MYRTOS_ReadyList_Move(Task_Config* taskReference, uint8_t Priority)
+{
+	if(taskReference->Priority == Priority)
+		return;
+
+	// Not ready: only its priority changes
+	if(taskReference->P_NextReadyTask == NULL)
 	{
-	case SVC_ActivateTask:
-	case SVC_TerminateTask:
-		// Update Scheduler table & Ready Queue
-		MYRTOS_Update_SchedulerTable();
+		taskReference->Priority = Priority;
+		return;
+	}
 
-		// if OS is in running state
-		if(OS_Control.OS_Modes_ID == OS_Running)
-		{
-			// Idle task would be called manually
-			if(strcmp(OS_Control.CurrentTaskExecuted->TaskName,"idleTask")!=0)
-			{
-				// Decide what next(Enqueue/Dequeue)
-				Decide_WhatNextTask();
+	MYRTOS_ReadyList_Remove(taskReference);
+	taskReference->Priority = Priority;
+	MYRTOS_ReadyList_Insert(taskReference);
+}
 
-				// Trigger OS_PendSV (Switch Context/Restore)
-				Trigger_OS_PendSV();
 
-			}
-		}
 
-		break;
+/**================================================================
+ * @Fn                - MYRTOS_Stack_Alloc
+ * @brief             - Gives a task its process stack (_S_PSP_Task, _E_PSP_Task)
+ * @param [in]        - taskReference: Pointer to the task configuration structure (Stack_Size)
+ * @retval            - MYRTOS_errorID: Task_Exceeded_Stack_Size if the stacks region is full
+ * Note              - O(1): a stack of a deleted task of the same size class is reused, else the stack is
+ *                     carved under the previous one (PSP_Task_Locator). Stacks of more than
+ *                     MYRTOS_STACK_CLASSES granules share one list, searched for their size
+ */
+
+MYRTOS_errorID MYRTOS_Stack_Alloc(Task_Config* taskReference)
+{
+#if MYRTOS_USE_TASK_DELETE
+	uint32_t Size = STACK_POOL_SIZE(taskReference->Stack_Size);
+	uint32_t* P_Link = &OS_Control.FreeStacks[STACK_POOL_CLASS(Size)];
+
+	// The first one of a size class list fits, the list of the larger stacks has different sizes
+	while((*P_Link != 0) && (FREE_STACK_SIZE(*P_Link) != Size))
+		P_Link = &FREE_STACK_NEXT(*P_Link);
+
+	if(*P_Link != 0)
+	{
+		taskReference->_S_PSP_Task = *P_Link;
+		taskReference->_E_PSP_Task = *P_Link - Size;
+		*P_Link = FREE_STACK_NEXT(*P_Link);
+
+		return NO_ERROR;
+	}
+#else
+	uint32_t Size = taskReference->Stack_Size;
+#endif
+
+	// Create its own PS Stack
+	taskReference->_S_PSP_Task = OS_Control.PSP_Task_Locator;
+	taskReference->_E_PSP_Task = (taskReference->_S_PSP_Task - Size + 7) & ~7UL;   // The guard word and the next stack stay aligned
+
+	// Check that task size isn't exceeding Process stack size
+	if(taskReference->_E_PSP_Task < (uint32_t)(&_eheap))
+		return Task_Exceeded_Stack_Size;
+
+	// Align 8 Byte for the next task PS stack
+	OS_Control.PSP_Task_Locator = taskReference->_E_PSP_Task - 8;
+
+	// - _S_PSP_Task
+	// - Task stack
+	// - _E_PSP_Task
 
-	case SVC_TaskWaitingTime:
-		MYRTOS_Update_SchedulerTable();
+	// - _eheap
 
+	return NO_ERROR;
+}
 
-		break;
 
 
-	case SVC_AcquireMutex:
+#if MYRTOS_USE_TASK_DELETE
+/**================================================================
+ * @Fn                - MYRTOS_Stack_Free
+ * @brief             - Gives the stack of a deleted task to the free list of its size class
+ * @param [in]        - taskReference: Pointer to the task configuration structure
+ * @retval            - None
+ * Note              - O(1). Only the top two words are written, the task may still be switched out on this stack
+ *                     (deleting itself), PendSV_Handler stacks its registers far below them
+ */
 
+// (Handler Mode)
+void MYRTOS_Stack_Free(Task_Config* taskReference)
+{
+	uint32_t Top = taskReference->_S_PSP_Task;
+	uint32_t Size = Top - taskReference->_E_PSP_Task;
+	uint32_t Class = STACK_POOL_CLASS(Size);
 
+	FREE_STACK_SIZE(Top) = Size;
+	FREE_STACK_NEXT(Top) = OS_Control.FreeStacks[Class];
+	OS_Control.FreeStacks[Class] = Top;
+}
+#endif
 
 
-		break;
 
-	case SVC_ReleaseMutex:
+/**================================================================
+ * @Fn                - Decide_WhatNextTask
+ * @brief             - Determine current task and next task to be run
+ * @param [in]        - None
+ * @param [in]        - None
+ * @retval            - None
+ * Note              - O(1), the highest ready priority is found by CLZ on the ready bitmap, the head of its
+ *                     list runs (MYRTOS_RoundRobin rotates it). The bitmap is never 0 (CLZ would give 32):
+ *                     the idle task is always ready, it can't be terminated or made to wait
+ */
 
 
+// (Handler Mode)
+void Decide_WhatNextTask()
+{
+	uint8_t HighestPriority = __CLZ(OS_Control.ReadyPriorityBitmap);
+	Task_Config* P_NextTask = OS_Control.ReadyList[HighestPriority];
+	Task_Config* P_Current = OS_Control.CurrentTaskExecuted;
+
+	OS_Control.ReadyChanged = 0;
+
+#if MYRTOS_USE_MUTEX
+	// Raised by a mutex (ceiling, inheritance): it runs before the tasks of that priority till it releases the mutex
+	// (a task using a Mutex_Ceiling mutex never finds it taken)
+	if((P_Current->P_NextReadyTask != NULL) && (P_Current->Priority == HighestPriority) &&
+			(P_Current->Priority < P_Current->Base_Priority))
+		P_NextTask = P_Current;
+#endif
+
+	if((P_Current != P_NextTask) && (P_Current->Task_State == Running))
+		P_Current->Task_State = Ready;
+
+#if MYRTOS_USE_STATISTICS
+	if(P_Current != P_NextTask)
+		P_NextTask->Stats.SwitchIns++;
+#endif
+
+	// If no other task is ready, the current task runs again (it is the next also)
+	P_NextTask->Task_State = Running;
+	OS_Control.NextTaskTobeExecuted = P_NextTask;
+}
 
-		break;
 
 
+/**================================================================
+ * @Fn                - MYRTOS_RoundRobin
+ * @brief             - Gives the CPU to the next task of the same priority as the current one
+ * @param [in]        - None
+ * @retval            - None
+ * Note              - O(1), called every tick (time slice) and by MYRTOS_Yield, the current task goes
+ *                     to the tail of its ready list. Nothing changes if it is alone in its priority
+ */
+
+// (Handler Mode)
+void MYRTOS_RoundRobin()
+{
+	uint8_t HighestPriority = __CLZ(OS_Control.ReadyPriorityBitmap);
+	Task_Config* P_Head = OS_Control.ReadyList[HighestPriority];
+
+	if((P_Head == OS_Control.CurrentTaskExecuted) && (P_Head->P_NextReadyTask != P_Head))
+	{
+		OS_Control.ReadyList[HighestPriority] = P_Head->P_NextReadyTask;
+		OS_Control.ReadyChanged = 1;
 	}
+}
+
+
+
+/**================================================================
+ * @Fn                - MYRTOS_SVC_ActivateTask
+ * @brief             - Kernel services (Handler Mode), called through SVC_Table
+ * @param [in]        - Args: Stacked r0-r3 of the caller (Args[0]: the task or the mutex of the service)
+ * @retval            - MYRTOS_errorID, written back to the stacked r0
+ * Note               - None
+ */
 
+uintptr_t MYRTOS_SVC_ActivateTask(uintptr_t* Args)
+{
+	Task_Config* P_Task = (Task_Config*)Args[0];
+
+	// Never created, or deleted (its stack may belong to another task now)
+	if(!TASK_IS_CREATED(P_Task))
+		return Task_Not_Created;
+
+	// A waiting task is woken before its time (it would be linked twice by its next wait), its call returns
+	// as if its timeout passed (its stacked r0 already holds the timeout result, Wait_Cancelled for a mutex)
+#if MYRTOS_USE_TIMING_WAIT
+	MYRTOS_WaitingList_Remove(P_Task);
+#endif
+#if MYRTOS_USE_MUTEX
+	MYRTOS_Mutex_CancelWait(P_Task);
+#endif
+	MYRTOS_WaitList_Remove(P_Task);
+	MYRTOS_ReadyList_Insert(P_Task);
+
+	return NO_ERROR;
+}
+
+uintptr_t MYRTOS_SVC_TerminateTask(uintptr_t* Args)
+{
+	Task_Config* P_Task = (Task_Config*)Args[0];
+
+	if(!TASK_IS_CREATED(P_Task))
+		return Task_Not_Created;
+
+	MYRTOS_ReadyList_Remove(P_Task);
+#if MYRTOS_USE_TIMING_WAIT
+	MYRTOS_WaitingList_Remove(P_Task);
+#endif
+#if MYRTOS_USE_MUTEX
+	MYRTOS_Mutex_CancelWait(P_Task);
+#endif
+	MYRTOS_WaitList_Remove(P_Task);
+	P_Task->Task_State = Suspend;
+
+	return NO_ERROR;
 }
 
+#if MYRTOS_USE_TIMING_WAIT
+// Args[1]: Ticks to wait
+uintptr_t MYRTOS_SVC_TaskWaitingTime(uintptr_t* Args)
+{
+	Task_Config* P_Task = (Task_Config*)Args[0];
+
+	if(!TASK_IS_CREATED(P_Task))
+		return Task_Not_Created;
+
+	// Suspended till its ticks pass
+	MYRTOS_ReadyList_Remove(P_Task);
+	P_Task->Task_State = Suspend;
+	P_Task->Time_Waiting.Ticks_Count = (uint32_t)Args[1];
+	MYRTOS_WaitingList_Insert(P_Task);
+
+	return NO_ERROR;
+}
+#endif
+
+#if MYRTOS_USE_MUTEX
+// The task owns the mutex (added to the mutexes it holds)
+void MYRTOS_Mutex_SetOwner(Mutex_Config* Mutex, Task_Config* taskReference)
+{
+	Mutex->currentTask = taskReference;
+	Mutex->P_NextHeld = taskReference->P_HeldMutexes;
+	taskReference->P_HeldMutexes = Mutex;
+}
+
+/**================================================================
+ * @Fn                - MYRTOS_Mutex_UpdatePriority
+ * @brief             - Sets the priority of a task from the mutexes it owns, then of the owners it waits for
+ * @param [in]        - taskReference: A task whose mutexes (or their waiters) changed
+ * @retval            - None
+ * Note              - Transitive priority inheritance: a task runs at the highest priority of its own one
+ *                     (Base_Priority), the first waiters of its mutexes and the ceilings of its Mutex_Ceiling
+ *                     mutexes, a change goes along the chain of owners (A waits for B who waits for C).
+ *                     At most MYRTOS_MAX_TASKS owners, each costs its mutexes and its place in a wait list
+ */
+
+// (Handler Mode)
+void MYRTOS_Mutex_UpdatePriority(Task_Config* taskReference)
+{
+	Mutex_Config* Mutex;
+	uint8_t Priority;
+	uint32_t Hops;
+
+	for(Hops = 0; (taskReference != NULL) && (Hops < MYRTOS_MAX_TASKS); Hops++)
+	{
+		Priority = taskReference->Base_Priority;
+		for(Mutex = taskReference->P_HeldMutexes; Mutex != NULL; Mutex = Mutex->P_NextHeld)
+		{
+			if((Mutex->P_Waiters != NULL) && (Mutex->P_Waiters->Priority < Priority))
+				Priority = Mutex->P_Waiters->Priority;
+			if((Mutex->Protocol == Mutex_Ceiling) && (Mutex->Ceiling_Priority < Priority))
+				Priority = Mutex->Ceiling_Priority;
+		}
+
+		if(Priority == taskReference->Priority)
+			return;
+
+		if(Priority < taskReference->Priority)
+			MYRTOS_TRACE(MYRTOS_TRACE_MUTEX_INHERIT, taskReference, Priority);
+		MYRTOS_ReadyList_Move(taskReference, Priority);
+
+		// Blocked on a kernel object (a mutex, a semaphore, ...): its place in the wait list
+		MYRTOS_WaitList_Requeue(taskReference);
+
+		// Waiting for a mutex: its owner inherits the new priority too
+		Mutex = taskReference->P_BlockingMutex;
+		if(Mutex == NULL)
+			return;
+
+		taskReference = Mutex->currentTask;
+	}
+}
 
 /**================================================================
- * @Fn                - PendSV_Handler
- * @brief             - Pendable Service (PendSV) Handler for context switching
+ * @Fn                - MYRTOS_Mutex_CancelWait
+ * @brief             - Takes a task out of the wait list of the mutex it waits for (activated, terminated, deleted)
+ * @param [in]        - taskReference: Pointer to the task configuration structure
  * @retval            - None
- * Note              - This function is a special interrupt handler used for context switching
- *                    in real-time operating systems. It is typically implemented in assembly.
+ * Note              - The owner may lose the priority it inherited from it
  */
 
+// (Handler Mode)
+void MYRTOS_Mutex_CancelWait(Task_Config* taskReference)
+{
+	Mutex_Config* Mutex = taskReference->P_BlockingMutex;
+
+	if(Mutex == NULL)
+		return;
+
+	MYRTOS_WaitList_Remove(taskReference);
+	taskReference->P_BlockingMutex = NULL;
+	MYRTOS_Mutex_UpdatePriority(Mutex->currentTask);
+}
 
-// Will be used in context switching
-__attribute ((naked)) void PendSV_Handler()
+// Args[1]: The task given by the caller (unused, the owner is the task running the call)
+uintptr_t MYRTOS_SVC_AcquireMutex(uintptr_t* Args)
 {
-	// Switch context & Restore
+	Mutex_Config* Mutex = (Mutex_Config*)Args[0];
+	Task_Config* P_Task = OS_Control.CurrentTaskExecuted;
+	Task_Config* P_Owner = Mutex->currentTask;
+	uint32_t Hops;
 
+	// An interrupt would give the mutex to the task it interrupted
+	if(MYRTOS_CALLED_FROM_ISR(Args) || (P_Task == NULL))
+		return Mutex_Unavailable;
 
-	/************************************
-	 * Save context for the current task
-	 ***********************************/
+	// A ceiling lower than the priority of a user can't keep the others from running
+	if((Mutex->Protocol == Mutex_Ceiling) &&
+			((Mutex->Ceiling_Priority >= MYRTOS_MAX_PRIORITIES) || (Mutex->Ceiling_Priority > P_Task->Base_Priority)))
+		return Mutex_Ceiling_Violation;
 
-	// Get current task "Current PSP from CPU Register after pushing xpsr-->r0"
-	// And put this value inside current PSP of the current task
-	OS_GET_PSP(OS_Control.CurrentTaskExecuted->Current_PSP);
+	if(P_Owner == NULL)
+	{
+		MYRTOS_Mutex_SetOwner(Mutex, P_Task);
+		// Mutex_Ceiling: raised to the ceiling at once, the tasks that may contend for it don't run till the release
+		MYRTOS_Mutex_UpdatePriority(P_Task);
+		return NO_ERROR;
+	}
 
-	// Using this PSP(pointer in the current task) to store (R4 to R11)
-	OS_Control.CurrentTaskExecuted->Current_PSP--;
-	__asm volatile("mov %0,r4":"=r" (*(OS_Control.CurrentTaskExecuted->Current_PSP)));
-	OS_Control.CurrentTaskExecuted->Current_PSP--;
-	__asm volatile("mov %0,r5":"=r" (*(OS_Control.CurrentTaskExecuted->Current_PSP)));
-	OS_Control.CurrentTaskExecuted->Current_PSP--;
-	__asm volatile("mov %0,r6":"=r" (*(OS_Control.CurrentTaskExecuted->Current_PSP)));
-	OS_Control.CurrentTaskExecuted->Current_PSP--;
-	__asm volatile("mov %0,r7":"=r" (*(OS_Control.CurrentTaskExecuted->Current_PSP)));
-	OS_Control.CurrentTaskExecuted->Current_PSP--;
-	__asm volatile("mov %0,r8":"=r" (*(OS_Control.CurrentTaskExecuted->Current_PSP)));
-	OS_Control.CurrentTaskExecuted->Current_PSP--;
-	__asm volatile("mov %0,r9":"=r" (*(OS_Control.CurrentTaskExecuted->Current_PSP)));
-	OS_Control.CurrentTaskExecuted->Current_PSP--;
-	__asm volatile("mov %0,r10":"=r" (*(OS_Control.CurrentTaskExecuted->Current_PSP)));
-	OS_Control.CurrentTaskExecuted->Current_PSP--;
-	__asm volatile("mov %0,r11":"=r" (*(OS_Control.CurrentTaskExecuted->Current_PSP)));
+	// Solve Deadlock problem: the owner waits (through other owners) for a mutex of the task,
+	// or the task owns this mutex already
+	for(Hops = 0; (P_Owner != NULL) && (Hops < MYRTOS_MAX_TASKS); Hops++)
+	{
+		if(P_Owner == P_Task)
+			return Mutex_Prevent_Deadlock;
 
+		P_Owner = (P_Owner->P_BlockingMutex != NULL) ? P_Owner->P_BlockingMutex->currentTask : NULL;
+	}
+
+	// Suspended till MYRTOS_SVC_ReleaseMutex hands it the mutex
+	if(!MYRTOS_WaitList_Block(&Mutex->P_Waiters, Args, MYRTOS_WAIT_FOREVER))
+		return Mutex_Unavailable;
+	P_Task->P_BlockingMutex = Mutex;
+	MYRTOS_TRACE(MYRTOS_TRACE_MUTEX_BLOCK, P_Task, (uintptr_t)Mutex);
+
+	// Priority inheritance protocol (to solve "Priority inversion"), along the chain of owners
+	MYRTOS_Mutex_UpdatePriority(Mutex->currentTask);
+
+	// MYRTOS_SVC_ReleaseMutex writes NO_ERROR when it hands the mutex over, this is left if the wait
+	// is cancelled (MYRTOS_Activate_Task)
+	return Wait_Cancelled;
+}
+
+uintptr_t MYRTOS_SVC_ReleaseMutex(uintptr_t* Args)
+{
+	Mutex_Config* Mutex = (Mutex_Config*)Args[0];
+	Task_Config* P_Owner = Mutex->currentTask;
+	Task_Config* P_NewOwner;
+	Mutex_Config** P_Held;
 
-	// Save the current value of PSP
-	// Already saved in the current PSP of this task
+	// Only its owner releases it (a free mutex, another task or an interrupt can't)
+	if(MYRTOS_CALLED_FROM_ISR(Args) || (P_Owner == NULL) || (P_Owner != OS_Control.CurrentTaskExecuted))
+		return Mutex_Unavailable;
 
+	// Not held by the owner anymore
+	P_Held = &P_Owner->P_HeldMutexes;
+	while((*P_Held != NULL) && (*P_Held != Mutex))
+		P_Held = &(*P_Held)->P_NextHeld;
+	if(*P_Held != NULL)
+		*P_Held = Mutex->P_NextHeld;
 
-	/************************************
-	 * Restore context for the next task
-	 ***********************************/
+	MYRTOS_TRACE(MYRTOS_TRACE_MUTEX_RELEASE, P_Owner, (uintptr_t)Mutex);
 
+	// The highest priority waiter (if any) owns the mutex now, and becomes ready
+	P_NewOwner = MYRTOS_WaitList_Wake(&Mutex->P_Waiters, NO_ERROR);
+	Mutex->currentTask = NULL;
 
-	if(OS_Control.NextTaskTobeExecuted != NULL)
+	if(P_NewOwner != NULL)
 	{
-		OS_Control.CurrentTaskExecuted = OS_Control.NextTaskTobeExecuted;
-		OS_Control.NextTaskTobeExecuted = NULL;
+		P_NewOwner->P_BlockingMutex = NULL;
+		MYRTOS_Mutex_SetOwner(Mutex, P_NewOwner);
+		MYRTOS_TRACE(MYRTOS_TRACE_MUTEX_TAKE, P_NewOwner, (uintptr_t)Mutex);
+
+		// It inherits from the waiters left (of its other mutexes, the ones of this mutex don't have a higher priority)
+		MYRTOS_Mutex_UpdatePriority(P_NewOwner);
 	}
 
+	// The old owner keeps what it inherits from the mutexes it still owns
+	MYRTOS_Mutex_UpdatePriority(P_Owner);
+
+	return NO_ERROR;
+}
+#endif
+
+uintptr_t MYRTOS_SVC_Yield(uintptr_t* Args)
+{
+	(void)Args;
+
+	MYRTOS_RoundRobin();
+
+	return NO_ERROR;
+}
+
+uintptr_t MYRTOS_SVC_CreateTask(uintptr_t* Args)
+{
+	return MYRTOS_Init_Task((Task_Config*)Args[0]);
+}
+
+#if MYRTOS_USE_TASK_DELETE
+uintptr_t MYRTOS_SVC_DeleteTask(uintptr_t* Args)
+{
+	Task_Config* P_Task = (Task_Config*)Args[0];
+	uint32_t Index = P_Task->TableIndex;
+
+	// The idle task runs when no other task is ready
+	if(P_Task == &MYRTOS_IdleTask)
+		return Task_Cant_Be_Deleted;
+
+	if(!TASK_IS_CREATED(P_Task))
+		return Task_Not_Created;
+
+#if MYRTOS_USE_MUTEX
+	// Its mutexes would stay owned forever (and their waiters blocked)
+	if(P_Task->P_HeldMutexes != NULL)
+		return Task_Owns_Mutex;
+#endif
+
+	MYRTOS_ReadyList_Remove(P_Task);
+#if MYRTOS_USE_TIMING_WAIT
+	MYRTOS_WaitingList_Remove(P_Task);
+#endif
+#if MYRTOS_USE_MUTEX
+	MYRTOS_Mutex_CancelWait(P_Task);
+#endif
+	MYRTOS_WaitList_Remove(P_Task);
+	P_Task->Task_State = Suspend;
+
+	// The last task of the table takes its place
+	OS_Control.ActiveTasksNum--;
+	OS_Control.OS_Tasks[Index] = OS_Control.OS_Tasks[OS_Control.ActiveTasksNum];
+	OS_Control.OS_Tasks[Index]->TableIndex = Index;
+	OS_Control.OS_Tasks[OS_Control.ActiveTasksNum] = NULL;
+
+	MYRTOS_Stack_Free(P_Task);
+	MYRTOS_Delete_Stack(P_Task);
+
+	return NO_ERROR;
+}
+#endif
+
+
+const SVC_Service_t SVC_Table[SVC_ServicesNum] = {
+	[SVC_ActivateTask]    = MYRTOS_SVC_ActivateTask,
+	[SVC_TerminateTask]   = MYRTOS_SVC_TerminateTask,
+#if MYRTOS_USE_TIMING_WAIT
+	[SVC_TaskWaitingTime] = MYRTOS_SVC_TaskWaitingTime,
+#endif
+#if MYRTOS_USE_MUTEX
+	[SVC_AcquireMutex]    = MYRTOS_SVC_AcquireMutex,
+	[SVC_ReleaseMutex]    = MYRTOS_SVC_ReleaseMutex,
+#endif
+	[SVC_Yield]           = MYRTOS_SVC_Yield,
+	[SVC_CreateTask]      = MYRTOS_SVC_CreateTask,
+#if MYRTOS_USE_TASK_DELETE
+	[SVC_DeleteTask]      = MYRTOS_SVC_DeleteTask,
+#endif
+#if MYRTOS_USE_MEMPOOL
+	[SVC_PoolAlloc]       = MYRTOS_SVC_PoolAlloc,
+	[SVC_PoolFree]        = MYRTOS_SVC_PoolFree,
+#endif
+#if MYRTOS_USE_RING
+	[SVC_RingWait]        = MYRTOS_SVC_RingWait,
+	[SVC_RingWake]        = MYRTOS_SVC_RingWake,
+#endif
+#if MYRTOS_USE_QUEUE
+	[SVC_QueueSend]       = MYRTOS_SVC_QueueSend,
+	[SVC_QueueReceive]    = MYRTOS_SVC_QueueReceive,
+#endif
+#if MYRTOS_USE_MAIL
+	[SVC_MailRef]         = MYRTOS_SVC_MailRef,
+#endif
+#if MYRTOS_USE_SEMAPHORE
+	[SVC_SemaphoreTake]   = MYRTOS_SVC_SemaphoreTake,
+	[SVC_SemaphoreGive]   = MYRTOS_SVC_SemaphoreGive,
+#endif
+};
+
+
+
+/**================================================================
+ * @Fn                - OS_SVC_Services
+ * @brief             - To execute specific OS service
+ * @param [in]        - StackFramePointer: the start of the current stack
+ * @param [in]        - None
+ * @retval            - None
+ * Note               - The service ID is the stacked r12, its arguments are the stacked r0-r3,
+ *                      its result is written to the stacked r0 (returned by the svc to the caller)
+ */
+
+
+// To execute specific OS service(Handler Mode)
+void OS_SVC_Services(uintptr_t* StackFramePointer)
+{
+	// SVC_Handler passes the stacked frame --> r0,r1,r2,r3,r12,lr,pc,xpsr
+
+	uint32_t ID = (uint32_t)StackFramePointer[4];
+
+#if MYRTOS_TICKLESS_IDLE
+	// Called from an interrupt during tickless idle: count the ticks passed till now
+	MYRTOS_Update_Tasks_WaitingTime(Ticker_Resume());
+#endif
 
+	MYRTOS_TRACE(MYRTOS_TRACE_SVC, OS_Control.CurrentTaskExecuted, ID);
+
+	if(ID >= SVC_ServicesNum)
+	{
+		StackFramePointer[0] = SVC_Invalid_Service;
+		return;
+	}
 
-	__asm volatile("mov r11,%0": : "r" (*(OS_Control.CurrentTaskExecuted->Current_PSP)));
-	OS_Control.CurrentTaskExecuted->Current_PSP++;
-	__asm volatile("mov r10,%0": : "r" (*(OS_Control.CurrentTaskExecuted->Current_PSP)));
-	OS_Control.CurrentTaskExecuted->Current_PSP++;
-	__asm volatile("mov r9,%0": : "r" (*(OS_Control.CurrentTaskExecuted->Current_PSP)));
-	OS_Control.CurrentTaskExecuted->Current_PSP++;
-	__asm volatile("mov r8,%0": : "r" (*(OS_Control.CurrentTaskExecuted->Current_PSP)));
-	OS_Control.CurrentTaskExecuted->Current_PSP++;
-	__asm volatile("mov r7,%0": : "r" (*(OS_Control.CurrentTaskExecuted->Current_PSP)));
-	OS_Control.CurrentTaskExecuted->Current_PSP++;
-	__asm volatile("mov r6,%0": : "r" (*(OS_Control.CurrentTaskExecuted->Current_PSP)));
-	OS_Control.CurrentTaskExecuted->Current_PSP++;
-	__asm volatile("mov r5,%0": : "r" (*(OS_Control.CurrentTaskExecuted->Current_PSP)));
-	OS_Control.CurrentTaskExecuted->Current_PSP++;
-	__asm volatile("mov r4,%0": : "r" (*(OS_Control.CurrentTaskExecuted->Current_PSP)));
-	OS_Control.CurrentTaskExecuted->Current_PSP++;
+	StackFramePointer[0] = SVC_Table[ID](StackFramePointer);
 
+	// if OS is in running state, decide again only if a task became ready or stopped being ready
+	if((OS_Control.OS_Modes_ID == OS_Running) && OS_Control.ReadyChanged)
+	{
+		// Decide what next
+		Decide_WhatNextTask();
 
-	// Update PSP to point to the task we want enter
-	OS_SET_PSP(OS_Control.CurrentTaskExecuted->Current_PSP);
+		// Trigger OS_PendSV (Switch Context/Restore)
+		Trigger_OS_PendSV();
+	}
 
-	__asm volatile("BX LR");
 }
 
 
@@ -367,6 +988,100 @@ void MYRTOS_Create_MainStack()
 uint8_t idleTaskIndication;
 
 
+#if MYRTOS_USE_STACK_WATERMARK
+// Progress of the idle task through the stacks
+struct{
+	Task_Config* P_Task;     // The task being scanned (NULL: start the next one)
+	uint32_t TaskIndex;      // Its index in OS_Tasks
+	uint32_t* P_Word;        // Next word to check
+}StackScan;
+
+
+
+/**================================================================
+ * @Fn                - MYRTOS_Paint_Stack
+ * @brief             - Fills the whole stack of a task with MYRTOS_STACK_PATTERN
+ * @param [in]        - taskReference: Pointer to the task configuration structure
+ * @retval            - None
+ * Note              - Called by MYRTOS_Create_Task before the first frame is pushed
+ */
+
+void MYRTOS_Paint_Stack(Task_Config* taskReference)
+{
+	uint32_t* P_Word = (uint32_t*)taskReference->_E_PSP_Task;
+
+	while((uint32_t)P_Word < taskReference->_S_PSP_Task)
+		*P_Word++ = MYRTOS_STACK_PATTERN;
+
+	taskReference->Stack_HighWater = 0;
+}
+
+
+
+/**================================================================
+ * @Fn                - MYRTOS_Scan_Stacks
+ * @brief             - Checks up to MYRTOS_STACK_SCAN_WORDS words of one stack, from its end towards its start
+ * @retval            - None
+ * Note              - Run by the idle task. The first word not holding the pattern gives the high-water mark,
+ *                     then the next task is scanned (stacks grow down, so the mark can only go deeper).
+ *                     A task is scanned again from the end of its stack if the table changed (MYRTOS_Delete_Task)
+ */
+
+void MYRTOS_Scan_Stacks()
+{
+	Task_Config* P_Task = StackScan.P_Task;
+	uint32_t* P_Word = StackScan.P_Word;
+	uint32_t WordsNum = MYRTOS_STACK_SCAN_WORDS;
+	uint32_t Used;
+
+	if(StackScan.TaskIndex >= OS_Control.ActiveTasksNum)
+		StackScan.TaskIndex = 0;
+
+	if((P_Task != OS_Control.OS_Tasks[StackScan.TaskIndex]) || ((uint32_t)P_Word < P_Task->_E_PSP_Task))
+	{
+		P_Task = OS_Control.OS_Tasks[StackScan.TaskIndex];
+		P_Word = (uint32_t*)P_Task->_E_PSP_Task;
+	}
+
+	while(WordsNum--)
+	{
+		if(((uint32_t)P_Word >= P_Task->_S_PSP_Task) || (*P_Word != MYRTOS_STACK_PATTERN))
+		{
+			Used = P_Task->_S_PSP_Task - (uint32_t)P_Word;
+			if(Used > P_Task->Stack_HighWater)
+				P_Task->Stack_HighWater = Used;
+
+			// The next task, from the end of its stack
+			StackScan.TaskIndex++;
+			StackScan.P_Task = NULL;
+			return;
+		}
+
+		P_Word++;
+	}
+
+	StackScan.P_Task = P_Task;
+	StackScan.P_Word = P_Word;
+}
+
+
+
+/**================================================================
+ * @Fn                - MYRTOS_Get_StackHighWater
+ * @brief             - Bytes of the stack of a task used at most (measured so far)
+ * @param [in]        - taskReference: Pointer to the task configuration structure
+ * @retval            - uint32_t: The high-water mark in bytes (Stack_Size - it = the bytes never used)
+ * Note              - Updated by the idle task, a task is measured again after all the others
+ */
+
+uint32_t MYRTOS_Get_StackHighWater(Task_Config* taskReference)
+{
+	return taskReference->Stack_HighWater;
+}
+#endif
+
+
+
 /**================================================================
  * @Fn                - MyRTOS_Idle_Task
  * @brief             - The idle task of the MYRTOS
@@ -380,7 +1095,12 @@ void MyRTOS_Idle_Task()
 	while(1)
 	{
 		idleTaskIndication^=1;
-		__asm("wfe");
+#if MYRTOS_USE_STACK_WATERMARK
+		// A few words of the stacks each time (nothing on the paths of the other tasks)
+		MYRTOS_Scan_Stacks();
+#endif
+		// Sleep till the next interrupt (the next wake up time during tickless idle)
+		OS_WAIT_FOR_INTERRUPT();
 	}
 }
 
@@ -401,18 +1121,20 @@ MYRTOS_errorID MYRTOS_Init()
 	// Specify the Main stack for the OS
 	MYRTOS_Create_MainStack();
 
-
-
-	// Create OS Ready Queue
-	if((FIFO_Init(&ReadyQueue, ReadyQueueFIFO, 100)) != FIFO_No_Error)
-		ErrorState += ReadyQueue_Init_Error;
-
+#if MYRTOS_USE_TRACE
+	MYRTOS_Trace_Init();
+#endif
+#if MYRTOS_USE_PROFILER
+	MYRTOS_Profiler_Init();
+#endif
 
 	// Configure idle task
+#if MYRTOS_USE_TASK_NAMES
 	strcpy(MYRTOS_IdleTask.TaskName,"idleTask");
-	MYRTOS_IdleTask.Priority = 255;    // The least priority
+#endif
+	MYRTOS_IdleTask.Priority = MYRTOS_IDLE_PRIORITY;    // The least priority
 	MYRTOS_IdleTask.P_TaskEntry = MyRTOS_Idle_Task;
-	MYRTOS_IdleTask.Stack_Size = 300;  // Bytes
+	MYRTOS_IdleTask.Stack_Size = MYRTOS_IDLE_STACK_SIZE;  // Bytes
 
 	ErrorState += MYRTOS_Create_Task(&MYRTOS_IdleTask);
 
@@ -422,151 +1144,111 @@ MYRTOS_errorID MYRTOS_Init()
 
 
 /**================================================================
- * @Fn                - MYRTOS_Create_Stack
- * @brief             - Creates a stack for a task in the MYRTOS
+ * @Fn                - MYRTOS_Create_Task
+ * @brief             - Creates a task in the MYRTOS
  * @param [in]        - taskReference: Pointer to the task configuration structure
- * @retval            - MYRTOS_errorID: Error code indicating the result of stack creation
- * Note              - This function should be called when defining and creating a task to allocate a stack for it.
+ * @retval            - MYRTOS_errorID: Error code indicating the result of task creation
+ * Note              - This function should be called when defining and creating a new task within the MYRTOS.
+ *                     Once the OS runs, the task is created by the kernel (the tables and the stacks are shared
+ *                     with the other tasks, MYRTOS_Delete_Task)
  */
 
-
-void MYRTOS_Create_Stack(Task_Config* taskReference)
+MYRTOS_errorID MYRTOS_Create_Task(Task_Config* taskReference)
 {
-	/** Task Frame
-	 * 	//// (Automatically pushed by processor)
-	 * 	- xpsr
-	 * 	- pc (next instrcution to be executed to this task)
-	 * 	- lr (Return register which is saved in cpu while task running before switching)
-	 * 	- r12
-	 * 	- r4
-	 * 	- r3
-	 * 	- r2
-	 * 	- r1
-	 * 	- r0
-	 *
-	 * 	//// (Manually defined to save the value of registers (Manually pushed and restored))
-	 * 	r5, r6, r7, r8, r9, r10, r11
-	 */
-	taskReference->Current_PSP = (uint32_t *)(taskReference->_S_PSP_Task);
-
-	taskReference->Current_PSP--;
-	*(taskReference->Current_PSP) = 0x01000000;  // Dummy psr (by default T=1 Thumb2) to avoid bus fault
-
-	taskReference->Current_PSP--;
-	*(taskReference->Current_PSP) = (unsigned int)(taskReference->P_TaskEntry);   // PC value
+	if(OS_Control.OS_Modes_ID == OS_Running)
+		return MYRTOS_SVC(SVC_CreateTask, taskReference, 0);
 
-	taskReference->Current_PSP--;
-	*(taskReference->Current_PSP) = (unsigned int)(0xFFFFFFFD);   // (Dummy value)As if LR (This function came from interrupt
-
-	// The rest is 13 registers we want to push with 0 for now
-	for(int j=0;j<13;j++)
-	{
-		taskReference->Current_PSP--;
-		*(taskReference->Current_PSP) = 0;
-	}
+	return MYRTOS_Init_Task(taskReference);
 }
 
 
 
 /**================================================================
- * @Fn                - MYRTOS_Create_Task
- * @brief             - Creates a task in the MYRTOS
+ * @Fn                - MYRTOS_Init_Task
+ * @brief             - Gives a task its stack and its place in the scheduler table, it stays suspended
  * @param [in]        - taskReference: Pointer to the task configuration structure
  * @retval            - MYRTOS_errorID: Error code indicating the result of task creation
- * Note              - This function should be called when defining and creating a new task within the MYRTOS.
+ * Note              - Called by MYRTOS_Create_Task (Handler Mode once the OS runs)
  */
 
-MYRTOS_errorID MYRTOS_Create_Task(Task_Config* taskReference)
+MYRTOS_errorID MYRTOS_Init_Task(Task_Config* taskReference)
 {
 	MYRTOS_errorID ErrorState = NO_ERROR;
 
-	// Create its own PS Stack
-	taskReference->_S_PSP_Task = OS_Control.PSP_Task_Locator;
-	taskReference->_E_PSP_Task = taskReference->_S_PSP_Task -  taskReference->Stack_Size;
-
-	// Check that task size isn't exceeding Process stack size
-	if(taskReference->_E_PSP_Task < (uint32_t)(&_eheap))
-		return Task_Exceeded_Stack_Size;
-
-	// Align 8 Byte for the next task PS stack
-	OS_Control.PSP_Task_Locator = taskReference->_E_PSP_Task - 8;
+	// Each priority has one bit in the ready bitmap
+	if(taskReference->Priority >= MYRTOS_MAX_PRIORITIES)
+		return Task_Invalid_Priority;
 
-	// - _S_PSP_Task
-	// - Task stack
-	// - _E_PSP_Task
+	// The scheduler table is full
+	if(OS_Control.ActiveTasksNum == MYRTOS_MAX_TASKS)
+		return Task_Exceeded_Max_Number;
 
-	// - _eheap
+	// A reused stack of a deleted task, or a new one under the previous stack
+	ErrorState = MYRTOS_Stack_Alloc(taskReference);
+	if(ErrorState != NO_ERROR)
+		return ErrorState;
 
+#if MYRTOS_USE_STACK_WATERMARK
+	MYRTOS_Paint_Stack(taskReference);
+#endif
+#if MYRTOS_USE_STACK_CHECK
+	// Guard word, checked by PendSV_Handler each time the task is switched out
+	*(uint32_t*)taskReference->_E_PSP_Task = MYRTOS_STACK_PATTERN;
+#endif
 
 	// Initialize PS Task Stack
 	MYRTOS_Create_Stack(taskReference);
 
 	// Update scheduler table
+	taskReference->TableIndex = OS_Control.ActiveTasksNum;
 	OS_Control.OS_Tasks[OS_Control.ActiveTasksNum] = taskReference;
 	OS_Control.ActiveTasksNum++;
 
+#if MYRTOS_USE_TRACE
+	MYRTOS_Trace_TaskCreated(taskReference);
+#endif
+
 	// Task state update (Suspend mode)
 	taskReference->Task_State = Suspend;
+	taskReference->P_NextReadyTask = NULL;
+	taskReference->P_PrevReadyTask = NULL;
+	taskReference->Object_Waiting.P_WaitList = NULL;
+#if MYRTOS_USE_MUTEX
+	taskReference->Base_Priority = taskReference->Priority;
+	taskReference->P_HeldMutexes = NULL;
+	taskReference->P_BlockingMutex = NULL;
+#endif
+#if MYRTOS_USE_TIMING_WAIT
+	taskReference->Time_Waiting.Block_Timing = Blocking_Disable;
+	taskReference->Time_Waiting.P_NextWaitingTask = NULL;
+	taskReference->Time_Waiting.P_PrevWaitingTask = NULL;
+#endif
+#if MYRTOS_USE_STATISTICS
+	taskReference->Stats.SwitchIns = 0;
+	taskReference->Stats.RunCycles = 0;
+#endif
 
 	return ErrorState;
 
 }
 
 
-/**================================================================
- * @Fn                - MYRTOS_OS_SVC_Set
- * @brief             - Provides an abstract to call SVC to perform some actions
- * @param [in]        - None
- * @retval            - None
- * Note              - None
- */
-
-void MYRTOS_OS_SVC_Set(SVC_ID ID)
-{
-	switch(ID)
-	{
-	case SVC_ActivateTask:
-		__asm("svc #0x00");
-		break;
-
-	case SVC_TerminateTask:
-		__asm("svc #0x01");
-		break;
-
-	case SVC_TaskWaitingTime:
-		__asm("svc #0x02");
-		break;
-
-	case SVC_AcquireMutex:
-		__asm("svc #0x03");
-		break;
-
-	case SVC_ReleaseMutex:
-		__asm("svc #0x04");
-		break;
-
-	}
-}
-
-
 /**================================================================
  * @Fn                - MYRTOS_Activate_Task
  * @brief             - Activates a task in the MYRTOS for execution
  * @param [in]        - taskReference: Pointer to the task configuration structure
- * @retval            - MYRTOS_errorID: Error code indicating the result of task activation
+ * @retval            - MYRTOS_errorID: Error code indicating the result of task activation (Task_Not_Created)
  * Note              - Call this function to activate a previously created task for execution within the MYRTOS.
+ *                     A task waiting (MYRTOS_Task_Wait, a kernel object) is woken at once, its call returns
+ *                     its timeout result (Wait_Cancelled from MYRTOS_AcquireMutex, without the mutex)
  */
 
 MYRTOS_errorID MYRTOS_Activate_Task(Task_Config* taskReference)
 {
 	MYRTOS_errorID ErrorState = NO_ERROR;
 
-	// Update task state
-	taskReference->Task_State = Waiting;
-
-
-	// Update Scheduler table
-	MYRTOS_OS_SVC_Set(SVC_ActivateTask);
+	// Add it to the ready list of its priority (a task already ready keeps its place and its state)
+	ErrorState = MYRTOS_SVC(SVC_ActivateTask, taskReference, 0);
 
 	return ErrorState;
 }
@@ -576,7 +1258,7 @@ MYRTOS_errorID MYRTOS_Activate_Task(Task_Config* taskReference)
  * @Fn                - MYRTOS_Terminate_Task
  * @brief             - Terminates a task in the MYRTOS
  * @param [in]        - taskReference: Pointer to the task configuration structure
- * @retval            - MYRTOS_errorID: Error code indicating the result of task termination
+ * @retval            - MYRTOS_errorID: Error code indicating the result of task termination (Task_Is_Idle, Task_Not_Created)
  * Note              - Call this function to terminate a previously activated task within the MYRTOS.
  */
 
@@ -585,57 +1267,168 @@ MYRTOS_errorID MYRTOS_Terminate_Task(Task_Config* taskReference)
 {
 	MYRTOS_errorID ErrorState = NO_ERROR;
 
-	taskReference->Task_State = Suspend;
+	// The idle task runs when no other task is ready
+	if(taskReference == &MYRTOS_IdleTask)
+		return Task_Is_Idle;
 
-	MYRTOS_OS_SVC_Set(SVC_TerminateTask);
+	ErrorState = MYRTOS_SVC(SVC_TerminateTask, taskReference, 0);
 
 	return ErrorState;
 }
 
+
+/**================================================================
+ * @Fn                - MYRTOS_Yield
+ * @brief             - Gives the CPU to the next ready task of the same priority
+ * @param [in]        - None
+ * @retval            - MYRTOS_errorID: NO_ERROR
+ * Note              - The caller goes to the tail of its ready list before its time slice ends,
+ *                     it continues at once if it is alone in its priority
+ */
+
+MYRTOS_errorID MYRTOS_Yield()
+{
+	return MYRTOS_SVC(SVC_Yield, 0, 0);
+}
+
+#if MYRTOS_USE_TASK_DELETE
+/**================================================================
+ * @Fn                - MYRTOS_Delete_Task
+ * @brief             - Removes a task from the MYRTOS, its stack is reused by the next task created with a stack of its size
+ * @param [in]        - taskReference: Pointer to the task configuration structure
+ * @retval            - MYRTOS_errorID: Task_Not_Created, Task_Cant_Be_Deleted (the idle task), Task_Owns_Mutex
+ * Note              - A task can delete itself (it never runs again). A task owning a mutex can't be deleted, a task
+ *                     waiting for one leaves its wait list and the owner drops what it inherited from it.
+ *                     The Task_Config can be created again (MYRTOS_Create_Task) after it
+ */
+
+MYRTOS_errorID MYRTOS_Delete_Task(Task_Config* taskReference)
+{
+	return MYRTOS_SVC(SVC_DeleteTask, taskReference, 0);
+}
+#endif
+
 /**================================================================
  * @Fn                - MYRTOS_Update_Tasks_WaitingTime
  * @brief             - Updates the waiting time of tasks in the MYRTOS
+ * @param [in]        - TicksNum: Number of ticks passed (more than one after a tickless idle period)
  * @retval            - None
- * Note              - Call this function to update the waiting time of tasks that are waiting for resources or events.
+ * Note              - Called every tick, only the head of the waiting list is decremented,
+ *                     all tasks due on this tick become ready before SysTick_Handler decides what next
  */
 
 
 
 
-void MYRTOS_Update_Tasks_WaitingTime()
+void MYRTOS_Update_Tasks_WaitingTime(uint32_t TicksNum)
 {
 	// Update time related to any task waiting for that time (Blocking based on time)
 
-	int i;
-	for(i=0;i<OS_Control.ActiveTasksNum;i++)
+	OS_Control.SystemTicks += TicksNum;
+
+#if MYRTOS_USE_TRACE
+	if(TicksNum != 0)
+		MYRTOS_TRACE(MYRTOS_TRACE_TICK, OS_Control.CurrentTaskExecuted, TicksNum);
+#endif
+
+#if MYRTOS_USE_TIMING_WAIT
+	Task_Config* P_Task = OS_Control.WaitingList;
+
+	while((P_Task != NULL) && (TicksNum != 0))
 	{
-		// Check if the task is suspended due to blocking based on time
-		if((OS_Control.OS_Tasks[i]->Task_State == Suspend) && (OS_Control.OS_Tasks[i]->Time_Waiting.Block_Timing == Blocking_Enable))
+		// The other tasks count after the head
+		if(P_Task->Time_Waiting.Ticks_Count > TicksNum)
+		{
+			P_Task->Time_Waiting.Ticks_Count -= TicksNum;
+			break;
+		}
+
+		TicksNum -= P_Task->Time_Waiting.Ticks_Count;
+		P_Task->Time_Waiting.Ticks_Count = 0;
+
+		// Wake the head, and the tasks due on the same tick
+		while((P_Task != NULL) && (P_Task->Time_Waiting.Ticks_Count == 0))
 		{
-			// Decrease its number of ticks
-			OS_Control.OS_Tasks[i]->Time_Waiting.Ticks_Count--;
-			if(OS_Control.OS_Tasks[i]->Time_Waiting.Ticks_Count == 1)
-			{
-				OS_Control.OS_Tasks[i]->Time_Waiting.Block_Timing = Blocking_Disable;
-				OS_Control.OS_Tasks[i]->Task_State = Waiting;
-				MYRTOS_OS_SVC_Set(SVC_TaskWaitingTime);
-			}
+			OS_Control.WaitingList = P_Task->Time_Waiting.P_NextWaitingTask;
+			if(OS_Control.WaitingList != NULL)
+				OS_Control.WaitingList->Time_Waiting.P_PrevWaitingTask = NULL;
+
+			P_Task->Time_Waiting.P_NextWaitingTask = NULL;
+			P_Task->Time_Waiting.Block_Timing = Blocking_Disable;
 
+			// Timeout of a task blocked on an object (its call returns the timeout result)
+			MYRTOS_WaitList_Remove(P_Task);
 
+			MYRTOS_ReadyList_Insert(P_Task);
+
+			P_Task = OS_Control.WaitingList;
 		}
 	}
+#endif
+}
+
+
+
+/**================================================================
+ * @Fn                - MYRTOS_Get_IdleTicks
+ * @brief             - Number of ticks only the idle task will run (used by tickless idle)
+ * @retval            - 0 if another task is ready, 0xFFFFFFFF if no task is waiting for time
+ * Note              - None
+ */
+
+// (Handler Mode)
+uint32_t MYRTOS_Get_IdleTicks()
+{
+	Task_Config* P_IdleList = OS_Control.ReadyList[MYRTOS_IDLE_PRIORITY];
+
+	// Another task is ready (or shares the idle priority)
+	if((OS_Control.ReadyPriorityBitmap != READY_PRIORITY_BIT(MYRTOS_IDLE_PRIORITY)) || (P_IdleList->P_NextReadyTask != P_IdleList))
+		return 0;
+
+#if MYRTOS_USE_TIMING_WAIT
+	if(OS_Control.WaitingList != NULL)
+		return OS_Control.WaitingList->Time_Waiting.Ticks_Count;
+#endif
+
+	return 0xFFFFFFFF;
+}
 
 
 
+/**================================================================
+ * @Fn                - MYRTOS_Get_SystemTicks
+ * @brief             - Number of ticks since the OS started
+ * @retval            - uint32_t: System ticks (1 tick = 1ms)
+ * Note              - Kept exact during tickless idle, it is corrected when the ticker resumes
+ */
+
+uint32_t MYRTOS_Get_SystemTicks()
+{
+	return OS_Control.SystemTicks;
 }
 
 
+
+/**================================================================
+ * @Fn                - MYRTOS_Get_CurrentTask
+ * @brief             - The task running now (the one interrupted, if called from an interrupt)
+ * @retval            - Task_Config*: The current task (NULL before MYRTOS_START_OS)
+ * Note              - None
+ */
+
+Task_Config* MYRTOS_Get_CurrentTask()
+{
+	return OS_Control.CurrentTaskExecuted;
+}
+
+
+#if MYRTOS_USE_TIMING_WAIT
 /**================================================================
  * @Fn                - MYRTOS_Task_Wait
  * @brief             - Puts a task in a waiting state for a specified time
  * @param [in]        - TicksNum: Number of system ticks to wait
  * @param [in]        - taskReference: Pointer to the task configuration structure
- * @retval            - MYRTOS_errorID: Error code indicating the result of the task wait operation
+ * @retval            - MYRTOS_errorID: Error code indicating the result of the task wait operation (Task_Is_Idle, Task_Not_Created)
  * Note              - Call this function to make a task wait for the specified number of system ticks.
  */
 
@@ -645,138 +1438,215 @@ MYRTOS_errorID MYRTOS_Task_Wait(uint32_t TicksNum, Task_Config* taskReference)
 {
 	MYRTOS_errorID ErrorState = NO_ERROR;
 
-	taskReference->Time_Waiting.Block_Timing = Blocking_Enable;
-	taskReference->Time_Waiting.Ticks_Count = TicksNum;
+	// The idle task runs when no other task is ready
+	if(taskReference == &MYRTOS_IdleTask)
+		return Task_Is_Idle;
 
-	// This task should be blocked (suspend for TicksNum)
-	taskReference->Task_State = Suspend;
+	// Nothing to wait
+	if(TicksNum == 0)
+		return ErrorState;
 
-	// To be suspended immediately until it reaches its TicksNum
-	MYRTOS_OS_SVC_Set(SVC_TerminateTask); // Will be handled as terminated
+	// This task should be blocked (suspend for TicksNum)
+	ErrorState = MYRTOS_SVC(SVC_TaskWaitingTime, taskReference, TicksNum);
 
 	return ErrorState;
 }
+#endif
 
 
-#define NUM_TASKS_ACQUIRED_MUTEX   10
-
-Task_Config *TasksAcquiringMutex[NUM_TASKS_ACQUIRED_MUTEX];
-uint8_t AcquiringCounter = 0;
-
-
+#if MYRTOS_USE_MUTEX
 /**================================================================
  * @Fn                - MYRTOS_AcquireMutex
  * @brief             - Attempts to acquire a mutex by a task in the MYRTOS
  * @param [in]        - Mutex: Pointer to the mutex configuration structure
- * @param [in]        - taskReference: Pointer to the task configuration structure
- * @retval            - MYRTOS_errorID: Error code indicating the result of the mutex acquisition
- * Note              - Call this function to allow a task to attempt to acquire the specified mutex.
+ * @param [in]        - taskReference: Pointer to the task configuration structure (kept for compatibility, the
+ *                      mutex goes to the task running the call)
+ * @retval            - MYRTOS_errorID: Mutex_Prevent_Deadlock (waiting would close a cycle of owners),
+ *                      Mutex_Unavailable (from an interrupt, or taken and the caller can't wait: the idle task),
+ *                      Mutex_Ceiling_Violation (Mutex_Ceiling, the task has a higher priority than the ceiling),
+ *                      Wait_Cancelled (woken by MYRTOS_Activate_Task while waiting, the mutex isn't taken)
+ * Note              - A task finding the mutex taken waits in its wait list (sorted by priority, of any length),
+ *                     the owner inherits its priority if higher. A Mutex_Ceiling mutex raises its owner to
+ *                     Ceiling_Priority when taken, so its users don't contend for it
  */
 
-
 MYRTOS_errorID MYRTOS_AcquireMutex(Mutex_Config *Mutex, Task_Config* taskReference)
 {
-	MYRTOS_errorID errorState = NO_ERROR;
+	// Taken or waited for in the kernel, so contenders don't race
+	return MYRTOS_SVC(SVC_AcquireMutex, Mutex, taskReference);
+}
 
 
-	// Check if the Mutex being locked by another task(And check its priority)
-	if(Mutex->currentTask != NULL)
-	{
-		// This Mutex supports two tasks only, one currently, and if another one waiting
-		if(Mutex->nextTask == NULL)
-		{
+/**================================================================
+ * @Fn                - MYRTOS_ReleaseMutex
+ * @brief             - Releases a previously acquired mutex
+ * @param [in]        - Mutex: Pointer to the mutex configuration structure
+ * @retval            - MYRTOS_errorID: Mutex_Unavailable (the caller doesn't own it: a free mutex, another task,
+ *                      an interrupt)
+ * Note              - The owner gets its priority back, the highest priority waiter owns the mutex
+ *                     and becomes ready in the same call
+ */
 
+MYRTOS_errorID MYRTOS_ReleaseMutex(Mutex_Config *Mutex)
+{
+	return MYRTOS_SVC(SVC_ReleaseMutex, Mutex, 0);
+}
+#endif
 
-			// Solve Deadlock problem, by preventing any task having mutex to acquire another one
-			for(int j=0;j<NUM_TASKS_ACQUIRED_MUTEX;j++)
-			{
-				if(taskReference == TasksAcquiringMutex[j])
-				{
-					return Mutex_Prevent_Deadlock;
-				}
-			}
+#if MYRTOS_USE_STATISTICS
+/**================================================================
+ * @Fn                - MYRTOS_Account_RunTime
+ * @brief             - Adds the cycles since the last accounting to the run time of a task
+ * @param [in]        - taskReference: The task that ran till now (the current task)
+ * @retval            - None
+ * Note              - Called by MYRTOS_PendSV_Hook on every tick and switch, so the 32 bit cycle counter
+ * 					   is read well before it wraps
+ */
 
-			Mutex->nextTask = taskReference;
-			taskReference->Task_State = Suspend;      // Suspended till releasing of the mutex
+// (Handler Mode)
+void MYRTOS_Account_RunTime(Task_Config* taskReference)
+{
+	uint32_t Now = OS_GET_CYCLES();
+	uint32_t Elapsed = Now - OS_Control.LastSwitchCycles;
 
-			// Priority inheritance protocol (to solve "Priority inversion")
-			if(Mutex->currentTask->Priority > Mutex->nextTask->Priority)
-			{
-				Mutex->currentTask->Priority = Mutex->nextTask->Priority;
-			}
+	OS_Control.LastSwitchCycles = Now;
+	OS_Control.TotalCycles += Elapsed;
+	taskReference->Stats.RunCycles += Elapsed;
+	OS_Control.AccountsNum++;
+}
 
 
-			MYRTOS_OS_SVC_Set(SVC_TerminateTask);
-		}else{
-			return MutexReachedMaximumNumber;
-		}
 
-	}else
-	{
+/**================================================================
+ * @Fn                - MYRTOS_Get_TaskRunTime
+ * @brief             - Cycles a task ran, and the cycles of all tasks, since the OS started
+ * @param [in]        - taskReference: Pointer to the task configuration structure
+ * @param [out]       - P_RunCycles: Cycles of the task, P_TotalCycles: Cycles of all tasks (can be NULL)
+ * @retval            - MYRTOS_errorID: NO_ERROR
+ * Note              - The running task is counted till now. The utilization of a window is the
+ * 					   difference of two readings (RunCycles2 - RunCycles1) / (TotalCycles2 - TotalCycles1)
+ */
 
+MYRTOS_errorID MYRTOS_Get_TaskRunTime(Task_Config* taskReference, uint64_t* P_RunCycles, uint64_t* P_TotalCycles)
+{
+	uint32_t AccountsNum, Elapsed;
+	uint64_t RunCycles, TotalCycles;
+
+	// PendSV_Handler may account while reading (tasks can't mask interrupts), read again till nothing changed
+	do{
+		AccountsNum = OS_Control.AccountsNum;
+		RunCycles = *(volatile uint64_t*)&taskReference->Stats.RunCycles;
+		TotalCycles = *(volatile uint64_t*)&OS_Control.TotalCycles;
+		Elapsed = OS_GET_CYCLES() - *(volatile uint32_t*)&OS_Control.LastSwitchCycles;
+
+		if(taskReference == OS_Control.CurrentTaskExecuted)
+			RunCycles += Elapsed;
+		TotalCycles += Elapsed;
+	}while(AccountsNum != OS_Control.AccountsNum);
+
+	*P_RunCycles = RunCycles;
+	if(P_TotalCycles != NULL)
+		*P_TotalCycles = TotalCycles;
+
+	return NO_ERROR;
+}
 
 
-		// Mutex is not locked by any task
-		Mutex->currentTask = taskReference;
-		// To Store the priority of the task in a variable, to restore it when the mutex is released
-		Mutex->Main_TaskPriority = Mutex->currentTask->Priority;
 
-		for(int j=0;j<NUM_TASKS_ACQUIRED_MUTEX;j++)
-		{
-			if(taskReference == TasksAcquiringMutex[j])
-			{
-				return errorState;
-			}
-		}
+/**================================================================
+ * @Fn                - MYRTOS_Get_TaskUtilization
+ * @brief             - CPU share of a task since the OS started
+ * @param [in]        - taskReference: Pointer to the task configuration structure
+ * @retval            - uint32_t: Utilization in 0.01% (10000 = the task had all the CPU)
+ * Note              - Interrupts are counted to the task they interrupted
+ */
 
+uint32_t MYRTOS_Get_TaskUtilization(Task_Config* taskReference)
+{
+	uint64_t RunCycles, TotalCycles;
 
-		TasksAcquiringMutex[AcquiringCounter] = taskReference;
-		AcquiringCounter++;
-	}
+	MYRTOS_Get_TaskRunTime(taskReference, &RunCycles, &TotalCycles);
 
-	return errorState;
+	if(TotalCycles == 0)
+		return 0;
+
+	return (uint32_t)((RunCycles * 10000U) / TotalCycles);
 }
 
 
+
 /**================================================================
- * @Fn                - MYRTOS_ReleaseMutex
- * @brief             - Releases a previously acquired mutex
- * @param [in]        - Mutex: Pointer to the mutex configuration structure
- * @retval            - MYRTOS_errorID: Error code indicating the result of the mutex release
- * Note              - Call this function to release a previously acquired mutex and make it available for other tasks.
+ * @Fn                - MYRTOS_Get_IdleUtilization
+ * @brief             - CPU share of the idle task since the OS started (the headroom left to the tasks)
+ * @retval            - uint32_t: Utilization in 0.01%
+ * Note              - None
  */
 
-MYRTOS_errorID MYRTOS_ReleaseMutex(Mutex_Config *Mutex)
+uint32_t MYRTOS_Get_IdleUtilization()
 {
-	MYRTOS_errorID errorState = NO_ERROR;
+	return MYRTOS_Get_TaskUtilization(&MYRTOS_IdleTask);
+}
+#endif
 
-	if(Mutex->currentTask != NULL)
-	{
-		// Restore the priority of the task
-		Mutex->currentTask->Priority = Mutex->Main_TaskPriority;
+#if MYRTOS_PENDSV_HOOK
+/**================================================================
+ * @Fn                - MYRTOS_PendSV_Hook
+ * @brief             - Run time statistics and trace of a context switch
+ * @param [in]        - P_Current: The task switched out, P_Next: The task switched in (the same on a tick without switch)
+ * @retval            - None
+ * Note              - Called by PendSV_Handler (interrupts disabled) on every tick and switch
+ */
 
-		Mutex->Main_TaskPriority = Mutex->nextTask->Priority;
+// (Handler Mode)
+void MYRTOS_PendSV_Hook(Task_Config* P_Current, Task_Config* P_Next)
+{
+#if MYRTOS_USE_STATISTICS
+	MYRTOS_Account_RunTime(P_Current);
+#endif
+
+#if MYRTOS_USE_TRACE
+	if(P_Current != P_Next)
+		MYRTOS_TRACE(MYRTOS_TRACE_TASK_SWITCH, P_Current, P_Next->TraceID);
+#endif
+}
+#endif
 
+#if MYRTOS_USE_STACK_CHECK
+/**================================================================
+ * @Fn                - MYRTOS_StackOverflow_Hook
+ * @brief             - Called when the stack of a task overflowed (weak, define it in the application)
+ * @param [in]        - taskReference: The task that overflowed its stack
+ * @retval            - None
+ * Note              - Handler mode with interrupts disabled, the stack below the task is corrupted,
+ * 					   log what is needed and reset (e.g. NVIC_SystemReset()). The kernel stops if it returns
+ */
 
-		for(int j=0;j<NUM_TASKS_ACQUIRED_MUTEX;j++)
-		{
-			if(Mutex->currentTask == TasksAcquiringMutex[j])
-			{
-				TasksAcquiringMutex[j] = NULL;
-			}
-		}
+__attribute__((weak)) void MYRTOS_StackOverflow_Hook(Task_Config* taskReference)
+{
+	(void)taskReference;
+}
 
-		Mutex->currentTask = Mutex->nextTask;
-		Mutex->nextTask = NULL;
 
-		// Exiting suspend mode
-		Mutex->currentTask->Task_State = Waiting;
-		MYRTOS_OS_SVC_Set(SVC_ActivateTask);
-	}
 
-	return errorState;
+/**================================================================
+ * @Fn                - MYRTOS_Stack_Overflow
+ * @brief             - Stops the kernel on a stack overflow of a task
+ * @param [in]        - P_Task: The task switched out by PendSV_Handler (its saved PSP passed _E_PSP_Task
+ * 					   or its guard word was overwritten)
+ * @retval            - None (never returns)
+ * Note              - Branched to by PendSV_Handler, interrupts stay disabled
+ */
 
+// (Handler Mode)
+void MYRTOS_Stack_Overflow(Task_Config* P_Task)
+{
+	OS_Control.OS_Modes_ID = OS_Suspend;
+
+	MYRTOS_StackOverflow_Hook(P_Task);
+
+	while(1);
 }
+#endif
 
 /**================================================================
  * @Fn                - MYRTOS_START_OS
@@ -788,21 +1658,24 @@ MYRTOS_errorID MYRTOS_ReleaseMutex(Mutex_Config *Mutex)
 
 void MYRTOS_START_OS()
 {
-	OS_Control.OS_Modes_ID = OS_Running;
 	// Set default "Current task == Idle task"
 	OS_Control.CurrentTaskExecuted = &MYRTOS_IdleTask;
 
-	// Activate Idle task
+	// Activate Idle task (before running, the first decision is on the first tick)
 	MYRTOS_Activate_Task(&MYRTOS_IdleTask);
 
+	OS_Control.OS_Modes_ID = OS_Running;
+#if MYRTOS_USE_STATISTICS
+	OS_Control.LastSwitchCycles = OS_GET_CYCLES();
+#endif
+#if MYRTOS_USE_TRACE
+	MYRTOS_Trace_Record(MYRTOS_TRACE_TASK_SWITCH, MYRTOS_TRACE_NO_TASK, MYRTOS_IdleTask.TraceID);
+#endif
+
 
 	// Start ticker
 	Start_Ticker();
 
-	OS_SET_PSP(OS_Control.CurrentTaskExecuted->Current_PSP);
-
-	// Switch thread mode from MSP to PSP
-	OS_SWITCH_SP_to_PSP;
-	OS_SWITCH_TO_UNPRIVILIGE;
-	MYRTOS_IdleTask.P_TaskEntry();
+	// Run the idle task on its process stack (never returns)
+	Start_FirstTask(OS_Control.CurrentTaskExecuted);
 }
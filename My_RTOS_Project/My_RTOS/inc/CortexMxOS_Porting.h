@@ -16,6 +16,15 @@ extern int _eheap;
 
 #define MainStackSize 2048  // 2K
 
+// 8 MHz (By default) --> 8000 counts = 1ms tick
+#define TICKER_COUNTS_PER_TICK		8000
+// SysTick is a 24 bit counter, the longest period it can wait (tickless idle)
+#define TICKER_MAX_TICKS			(0x01000000UL / TICKER_COUNTS_PER_TICK)
+
+// Priority of SysTick and SVC (set by HW_Init / Start_Ticker), interrupts calling the kernel must have it too,
+// so none of them preempts another in the middle of a list update. PendSV is below it (15)
+#define OS_KERNEL_PRIORITY			14
+
 
 #define OS_SET_PSP(address) 		__asm volatile("mov r0,%0 \n\t msr psp,r0" : : "r"(address))
 #define OS_GET_PSP(address) 		__asm volatile("mrs r0,psp \n\t mov %0,r0" : "=r"(address))
@@ -28,12 +37,68 @@ extern int _eheap;
 // Clear bit0 --> privilige
 #define OS_SWITCH_TO_PRIVILIGE		__asm volatile("mrs r3,CONTROL \n\t lsr r3,r3,#0x1 \n\t lsl r3,r3,#0x1 \n\t msr CONTROL,r3")
 
+#define OS_SVC_CALL(ID, Arg0, Arg1, Arg2, Arg3)		OS_SVC_Call((ID), (Arg0), (Arg1), (Arg2), (Arg3))
+
+#define OS_WAIT_FOR_INTERRUPT()		__WFI()
+
+// Run time statistics and trace (core cycles, enabled by HW_Init)
+#define OS_GET_CYCLES()				(DWT->CYCCNT)
+#define OS_CYCLES_PER_US			(TICKER_COUNTS_PER_TICK / 1000)    // SysTick runs from the core clock
+// Running interrupt (handler mode)
+#define OS_GET_IRQ_NUMBER()			((uint16_t)(__get_IPSR() - 16))
+
+// Memory accesses before it complete before the ones after it (lock-free rings)
+#define OS_MEMORY_BARRIER()			__DMB()
+
+// Constants in the naked handlers (e.g. "ldr r12,[r1,#" OS_STRINGIFY(OFFSET) "]")
+#define OS_STRINGIFY_(x)			#x
+#define OS_STRINGIFY(x)				OS_STRINGIFY_(x)
+
+/**================================================================
+ * @Fn					- OS_SVC_Call
+ * @brief 				- Enters the kernel (svc #0) to run the service ID
+ * @param [in] 			- ID: The service (bound to r12), Arg0..Arg3: Its arguments (bound to r0-r3)
+ * @retval 				- The result of the service (the stacked r0 written by the kernel)
+ * Note					- The processor stacks r0-r3 and r12, so the kernel reads them from the exception frame.
+ * 						 From an interrupt (it must have OS_KERNEL_PRIORITY, the priority of SysTick and SVC) svc would
+ * 						 fault, so the kernel runs directly on a frame built here
+ */
+
+void OS_SVC_Services(uintptr_t* StackFramePointer);
+
+static inline uintptr_t OS_SVC_Call(uint32_t ID, uintptr_t Arg0, uintptr_t Arg1, uintptr_t Arg2, uintptr_t Arg3)
+{
+	if(__get_IPSR() != 0)
+	{
+		// r0,r1,r2,r3,r12,lr,pc,xpsr (its exception number tells the kernel that an interrupt called)
+		uintptr_t StackFrame[8] = {Arg0, Arg1, Arg2, Arg3, ID, 0, 0, __get_IPSR()};
+
+		OS_SVC_Services(StackFrame);
+
+		return StackFrame[0];
+	}
+
+	register uintptr_t r0 __asm("r0") = Arg0;
+	register uintptr_t r1 __asm("r1") = Arg1;
+	register uintptr_t r2 __asm("r2") = Arg2;
+	register uintptr_t r3 __asm("r3") = Arg3;
+	register uint32_t r12 __asm("r12") = ID;
+
+	__asm volatile("svc #0" : "+r"(r0) : "r"(r1), "r"(r2), "r"(r3), "r"(r12) : "memory");
+
+	return r0;
+}
+
 void HW_Init(void);
 
 void Trigger_OS_PendSV(void);
 
 void Start_Ticker(void);
 
+void Ticker_Restart(uint32_t Counts);
+void Ticker_Suppress(uint32_t TicksNum);
+uint32_t Ticker_Resume(void);
+
 
 
 #endif /* INC_CORTEXMXOS_PORTING_H_ */
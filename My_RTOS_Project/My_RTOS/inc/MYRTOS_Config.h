@@ -0,0 +1,159 @@
+/*
+ * MYRTOS_Config.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Abdallah
+ */
+
+#ifndef INC_MYRTOS_CONFIG_H_
+#define INC_MYRTOS_CONFIG_H_
+
+
+// Kernel configuration: limits and features (each one can be overridden with -D)
+// Tables are sized by the limits, a disabled feature leaves no code or data in the kernel
+// The optional services and checks are off by default, an application enables the ones it uses
+
+
+// Number of tasks that can be created (with the idle task)
+#ifndef MYRTOS_MAX_TASKS
+#define MYRTOS_MAX_TASKS			8
+#endif
+
+// Number of priority levels (0 is the highest, the idle task takes the least one), up to 32 (one bit each in the ready bitmap)
+#ifndef MYRTOS_MAX_PRIORITIES
+#define MYRTOS_MAX_PRIORITIES		16
+#endif
+
+// Stack of the idle task (Bytes)
+#ifndef MYRTOS_IDLE_STACK_SIZE
+#define MYRTOS_IDLE_STACK_SIZE		300
+#endif
+
+// 1: Mutexes (MYRTOS_AcquireMutex, MYRTOS_ReleaseMutex) with priority inheritance
+#ifndef MYRTOS_USE_MUTEX
+#define MYRTOS_USE_MUTEX			1
+#endif
+
+// 1: Counting / binary semaphores (MYRTOS_Semaphore_Take, MYRTOS_Semaphore_Give), given from tasks and interrupts
+#ifndef MYRTOS_USE_SEMAPHORE
+#define MYRTOS_USE_SEMAPHORE		0
+#endif
+
+// 1: Fixed-block memory pools (MYRTOS_Pool_Alloc, MYRTOS_Pool_Free), from tasks and interrupts
+#ifndef MYRTOS_USE_MEMPOOL
+#define MYRTOS_USE_MEMPOOL			0
+#endif
+
+// 1: Lock-free single producer / single consumer rings (MYRTOS_Ring_Push, MYRTOS_Ring_Pop), interrupt to task
+#ifndef MYRTOS_USE_RING
+#define MYRTOS_USE_RING				0
+#endif
+
+// 1: Blocking message queues (MYRTOS_Queue_Send, MYRTOS_Queue_Receive) with timeouts
+#ifndef MYRTOS_USE_QUEUE
+#define MYRTOS_USE_QUEUE			0
+#endif
+
+// 1: Zero-copy mails (MYRTOS_Mail_Post, MYRTOS_Mail_Fetch), pool blocks passed by pointer with a reference count
+#ifndef MYRTOS_USE_MAIL
+#define MYRTOS_USE_MAIL				0
+#endif
+
+// 1: Tasks (and mutexes) have a name (TaskName / MutexName) of MYRTOS_NAME_LENGTH characters
+#ifndef MYRTOS_USE_TASK_NAMES
+#define MYRTOS_USE_TASK_NAMES		1
+#endif
+
+#ifndef MYRTOS_NAME_LENGTH
+#define MYRTOS_NAME_LENGTH			30
+#endif
+
+// 1: Tasks can wait for a number of ticks (MYRTOS_Task_Wait)
+#ifndef MYRTOS_USE_TIMING_WAIT
+#define MYRTOS_USE_TIMING_WAIT		1
+#endif
+
+// 1: The kernel counts how many times each task was switched in and the cycles it ran (Task_Config.Stats),
+//    MYRTOS_Get_TaskUtilization() gives the CPU share of each task (the cycle counter of the port: DWT->CYCCNT)
+#ifndef MYRTOS_USE_STATISTICS
+#define MYRTOS_USE_STATISTICS		0
+#endif
+
+// 1: MYRTOS_Delete_Task, the stacks of deleted tasks are kept in free lists by size and reused by MYRTOS_Create_Task
+#ifndef MYRTOS_USE_TASK_DELETE
+#define MYRTOS_USE_TASK_DELETE		0
+#endif
+
+// Stacks are rounded up to a multiple of it (bytes, multiple of 8), each multiple is a size class
+#ifndef MYRTOS_STACK_GRANULE
+#define MYRTOS_STACK_GRANULE		128
+#endif
+
+// Size classes with an O(1) free list (stacks up to MYRTOS_STACK_CLASSES * MYRTOS_STACK_GRANULE bytes),
+// the larger stacks share one more list, searched for their size
+#ifndef MYRTOS_STACK_CLASSES
+#define MYRTOS_STACK_CLASSES		16
+#endif
+
+// 1: Task stacks are painted at creation, the idle task finds how deep each one was used (MYRTOS_Get_StackHighWater)
+#ifndef MYRTOS_USE_STACK_WATERMARK
+#define MYRTOS_USE_STACK_WATERMARK	0
+#endif
+
+// Stack words checked by the idle task each time it wakes up
+#ifndef MYRTOS_STACK_SCAN_WORDS
+#define MYRTOS_STACK_SCAN_WORDS		16
+#endif
+
+// 1: PendSV_Handler checks the stack of the task it switches out (saved PSP vs _E_PSP_Task, guard word),
+//    an overflow calls MYRTOS_StackOverflow_Hook and stops the kernel
+#ifndef MYRTOS_USE_STACK_CHECK
+#define MYRTOS_USE_STACK_CHECK		0
+#endif
+
+// 1: The kernel records task switches, services, mutexes and ticks in a RAM ring (My_RTOS_Trace.h)
+#ifndef MYRTOS_USE_TRACE
+#define MYRTOS_USE_TRACE			0
+#endif
+
+// Records of the trace ring (8 bytes each), a power of two
+#ifndef MYRTOS_TRACE_RECORDS
+#define MYRTOS_TRACE_RECORDS		256
+#endif
+
+// 1: Every tick samples the interrupted PC and the current task (My_RTOS_Profiler.h)
+//    Tickless idle periods are one sample weighted by their ticks
+#ifndef MYRTOS_USE_PROFILER
+#define MYRTOS_USE_PROFILER			0
+#endif
+
+// Entries of the profile, (PC, task) pairs (12 bytes each), a power of two
+#ifndef MYRTOS_PROFILER_SLOTS
+#define MYRTOS_PROFILER_SLOTS		64
+#endif
+
+// 1: The ticker is stopped till the next wake up time while only the idle task is ready
+#ifndef MYRTOS_TICKLESS_IDLE
+#define MYRTOS_TICKLESS_IDLE		0
+#endif
+
+// 1: Tasks run privileged (can access the system registers, e.g. DWT cycle counter in the benchmarks)
+#ifndef MYRTOS_PRIVILEGED_TASKS
+#define MYRTOS_PRIVILEGED_TASKS		0
+#endif
+
+
+#if (MYRTOS_MAX_PRIORITIES < 2) || (MYRTOS_MAX_PRIORITIES > 32)
+#error "MYRTOS_MAX_PRIORITIES must be 2..32 (one bit each in the ready bitmap)"
+#endif
+
+#if MYRTOS_USE_MAIL && !(MYRTOS_USE_MEMPOOL && MYRTOS_USE_QUEUE)
+#error "MYRTOS_USE_MAIL needs MYRTOS_USE_MEMPOOL and MYRTOS_USE_QUEUE"
+#endif
+
+#if (MYRTOS_MAX_TASKS < 2) || (MYRTOS_MAX_TASKS > 255)
+#error "MYRTOS_MAX_TASKS must be 2..255 (room for the idle task and one task, Task_Config.TableIndex is 8 bit)"
+#endif
+
+
+#endif /* INC_MYRTOS_CONFIG_H_ */
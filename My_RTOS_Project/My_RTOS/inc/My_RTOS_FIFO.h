@@ -8,20 +8,26 @@
 #ifndef INC_MY_RTOS_FIFO_H_
 #define INC_MY_RTOS_FIFO_H_
 
-#include "stdio.h"
 #include "stdint.h"
-#include "Schedular.h"
 
-// Determined by the user
-#define Element_Type Task_Config*   // Pointer to the task
+
+// Ring buffer of elements of any size (chosen at FIFO_Init), the length is a power of two:
+// head and tail run freely and are masked to index the buffer, so tail - head is the count
+// (a full FIFO isn't mistaken for an empty one) and wrapping needs no branch.
+// Not protected, one context at a time (the kernel objects using it run in the kernel)
+
+
+// Buffer of a FIFO of Length (power of two) elements of Type
+#define FIFO_BUFFER(Name, Type, Length)		Type Name[Length]; \
+											_Static_assert(((Length) & ((Length) - 1)) == 0, #Name ": FIFO length must be a power of two")
 
 
 typedef struct{
-	uint32_t counter;
-	Element_Type* head;
-	Element_Type* tail;
-	Element_Type* base;
-	uint32_t length;
+	uint8_t* base;
+	uint32_t element_size;    // Bytes
+	uint32_t mask;            // length - 1
+	uint32_t head;            // Next element to dequeue (free running, & mask for the index)
+	uint32_t tail;            // Next element to enqueue (free running)
 }FIFO_Buffer_t;
 
 
@@ -29,14 +35,25 @@ typedef enum{
 	FIFO_No_Error,
 	FIFO_Full,
 	FIFO_Empty,
-	FIFO_Null
+	FIFO_Null,
+	FIFO_Invalid_Length
 }FIFO_Status;
 
 
 
-FIFO_Status FIFO_Init(FIFO_Buffer_t *fifo, Element_Type* Buffer, uint32_t length);
-FIFO_Status FIFO_Enqeue(FIFO_Buffer_t *fifo, Element_Type Item);
-FIFO_Status FIFO_Deqeue(FIFO_Buffer_t *fifo, Element_Type* Item);
+FIFO_Status FIFO_Init(FIFO_Buffer_t *fifo, void* Buffer, uint32_t element_size, uint32_t length);
+FIFO_Status FIFO_Enqeue(FIFO_Buffer_t *fifo, const void* Item);
+FIFO_Status FIFO_Deqeue(FIFO_Buffer_t *fifo, void* Item);
+uint32_t FIFO_Enqeue_Batch(FIFO_Buffer_t *fifo, const void* Items, uint32_t Num);
+uint32_t FIFO_Deqeue_Batch(FIFO_Buffer_t *fifo, void* Items, uint32_t Num);
 FIFO_Status FIFO_Is_Full(FIFO_Buffer_t *fifo);
 
+
+// Elements in the FIFO, and free places
+#define FIFO_Count(fifo)				((fifo)->tail - (fifo)->head)
+#define FIFO_Free(fifo)					((fifo)->mask + 1 - FIFO_Count(fifo))
+
+// Address of the element at (free running) index
+#define FIFO_ELEMENT(fifo, index)		((fifo)->base + (((index) & (fifo)->mask) * (fifo)->element_size))
+
 #endif /* INC_MY_RTOS_FIFO_H_ */
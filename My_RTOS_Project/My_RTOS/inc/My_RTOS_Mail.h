@@ -0,0 +1,54 @@
+/*
+ * My_RTOS_Mail.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Abdallah
+ */
+
+#ifndef INC_MY_RTOS_MAIL_H_
+#define INC_MY_RTOS_MAIL_H_
+
+#include "stdint.h"
+#include "Schedular.h"
+#include "My_RTOS_MemPool.h"
+#include "My_RTOS_Queue.h"
+
+
+// Zero-copy mails (MYRTOS_USE_MAIL): a mail is a block of a memory pool, the producer fills it and posts its
+// pointer to a mailbox (a queue of pointers), the consumer fetches the pointer and releases the mail.
+// A mail counts its references: posting it to several mailboxes (MYRTOS_Mail_Broadcast) gives a reference
+// to each consumer, the block goes back to its pool with the last release
+
+
+// Header before the data of a mail (in its block)
+typedef struct{
+	struct MYRTOS_Pool* P_Pool;        // Not entered by the user (the pool of the block)
+	uint32_t RefCount;                 // Not entered by the user
+}MYRTOS_MailHeader_t;
+
+// Block size in a pool of mails of DataSize bytes
+#define MYRTOS_MAIL_BLOCK_SIZE(DataSize)				(sizeof(MYRTOS_MailHeader_t) + (DataSize))
+
+// Storage of a pool of BlocksNum mails of DataSize bytes (MYRTOS_Pool_Init with MYRTOS_MAIL_BLOCK_SIZE(DataSize))
+#define MYRTOS_MAIL_POOL_STORAGE(Name, DataSize, BlocksNum)		MYRTOS_POOL_STORAGE(Name, MYRTOS_MAIL_BLOCK_SIZE(DataSize), BlocksNum)
+
+// Storage of a mailbox of Length (power of two) mails
+#define MYRTOS_MAILBOX_STORAGE(Name, Length)			MYRTOS_QUEUE_STORAGE(Name, sizeof(void*), Length)
+
+
+#if MYRTOS_USE_MAIL
+
+typedef MYRTOS_Queue_t MYRTOS_Mailbox_t;
+
+
+MYRTOS_errorID MYRTOS_Mailbox_Init(MYRTOS_Mailbox_t* Mailbox, void* Storage, uint32_t Length);
+void* MYRTOS_Mail_Alloc(MYRTOS_Pool_t* Pool, uint32_t Timeout);
+MYRTOS_errorID MYRTOS_Mail_Post(MYRTOS_Mailbox_t* Mailbox, void* Mail, uint32_t Timeout);
+MYRTOS_errorID MYRTOS_Mail_Broadcast(MYRTOS_Mailbox_t* const Mailboxes[], uint32_t MailboxesNum, void* Mail, uint32_t Timeout);
+MYRTOS_errorID MYRTOS_Mail_Fetch(MYRTOS_Mailbox_t* Mailbox, void** P_Mail, uint32_t Timeout);
+MYRTOS_errorID MYRTOS_Mail_Release(void* Mail);
+
+#endif
+
+
+#endif /* INC_MY_RTOS_MAIL_H_ */
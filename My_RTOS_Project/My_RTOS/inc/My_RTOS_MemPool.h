@@ -0,0 +1,48 @@
+/*
+ * My_RTOS_MemPool.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Abdallah
+ */
+
+#ifndef INC_MY_RTOS_MEMPOOL_H_
+#define INC_MY_RTOS_MEMPOOL_H_
+
+#include "stdint.h"
+#include "Schedular.h"
+
+
+// Fixed-block memory pools (MYRTOS_USE_MEMPOOL): the storage is given by the user, free blocks are linked through
+// their first word, so allocating and freeing are O(1). Tasks and interrupts can allocate and free, a task can
+// wait for a block (a block freed is handed to the first waiter)
+
+
+// Block size in a pool: rounded up to a pointer (a free block holds the link to the next one)
+#define MYRTOS_POOL_BLOCK_SIZE(BlockSize)		((((BlockSize) + sizeof(uintptr_t) - 1) / sizeof(uintptr_t)) * sizeof(uintptr_t))
+
+// Storage of BlocksNum blocks of BlockSize bytes (aligned to a pointer)
+#define MYRTOS_POOL_STORAGE(Name, BlockSize, BlocksNum)		uintptr_t Name[(MYRTOS_POOL_BLOCK_SIZE(BlockSize) / sizeof(uintptr_t)) * (BlocksNum)]
+
+
+#if MYRTOS_USE_MEMPOOL
+
+typedef struct MYRTOS_Pool{
+	void* P_FreeList;                  // Not entered by the user (the first word of a free block points to the next one)
+	uint8_t* P_Storage;                // Not entered by the user
+	uint32_t BlockSize;                // Not entered by the user (bytes, MYRTOS_POOL_BLOCK_SIZE)
+	uint32_t BlocksNum;                // Not entered by the user
+	uint32_t FreeBlocksNum;            // Not entered by the user
+	uint32_t MinFreeBlocksNum;         // Not entered by the user (the least free blocks so far, to size the pool)
+	struct Task_Config* P_Waiters;     // Not entered by the user (tasks waiting for a block, sorted by priority)
+}MYRTOS_Pool_t;
+
+
+MYRTOS_errorID MYRTOS_Pool_Init(MYRTOS_Pool_t* Pool, void* Storage, uint32_t BlockSize, uint32_t BlocksNum);
+void* MYRTOS_Pool_Alloc(MYRTOS_Pool_t* Pool, uint32_t Timeout);
+MYRTOS_errorID MYRTOS_Pool_Free(MYRTOS_Pool_t* Pool, void* P_Block);
+uint32_t MYRTOS_Pool_Get_FreeBlocks(MYRTOS_Pool_t* Pool);
+
+#endif
+
+
+#endif /* INC_MY_RTOS_MEMPOOL_H_ */
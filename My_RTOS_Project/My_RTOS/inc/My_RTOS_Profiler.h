@@ -0,0 +1,62 @@
+/*
+ * My_RTOS_Profiler.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Abdallah
+ */
+
+#ifndef INC_MY_RTOS_PROFILER_H_
+#define INC_MY_RTOS_PROFILER_H_
+
+#include "stdint.h"
+#include "MYRTOS_Config.h"
+
+
+// Statistical profiler (MYRTOS_USE_PROFILER): every tick, the PC of the interrupted code (from the stacked exception
+// frame) and the current task are counted in MYRTOS_Profile, a hash table of (PC, task) --> samples
+// Dump MYRTOS_Profile from the target (e.g. gdb: dump binary value profile.bin MYRTOS_Profile) or take a whole RAM image,
+// then Tools/myrtos_profile.py symbolizes it against the executable (My_RTOS_Project.axf) into a flat profile
+// and a flame graph (folded stacks)
+
+
+#define MYRTOS_PROFILE_MAGIC		0x4650594DUL    // "MYPF"
+#define MYRTOS_PROFILE_VERSION		1
+
+// Bit 0 of the task of a sample (Task_Config is word aligned): the tick interrupted a handler, not the task
+#define MYRTOS_PROFILE_IN_HANDLER	0x1UL
+
+
+typedef struct{
+	uint32_t PC;                       // Interrupted instruction
+	uint32_t Task;                     // Address of the current Task_Config (| MYRTOS_PROFILE_IN_HANDLER)
+	uint32_t Count;                    // Samples (ticks), 0: free slot
+}MYRTOS_ProfileSlot_t;
+
+
+#if MYRTOS_USE_PROFILER
+
+#if (MYRTOS_PROFILER_SLOTS & (MYRTOS_PROFILER_SLOTS - 1)) != 0
+#error "MYRTOS_PROFILER_SLOTS must be a power of two"
+#endif
+
+// Layout read by Tools/myrtos_profile.py (little endian, keep MYRTOS_PROFILE_VERSION in step)
+typedef struct{
+	uint32_t Magic;                    // MYRTOS_PROFILE_MAGIC
+	uint16_t Version;
+	uint16_t SlotSize;
+	uint32_t SlotsNum;
+	uint32_t Samples;                  // All the samples (ticks)
+	uint32_t Dropped;                  // Samples not counted, the table was full
+	MYRTOS_ProfileSlot_t Slots[MYRTOS_PROFILER_SLOTS];
+}MYRTOS_Profile_t;
+
+extern MYRTOS_Profile_t MYRTOS_Profile;
+
+
+void MYRTOS_Profiler_Init(void);
+void MYRTOS_Profiler_Sample(uint32_t PC, uint8_t InHandler, uint32_t TicksNum);
+
+#endif
+
+
+#endif /* INC_MY_RTOS_PROFILER_H_ */
@@ -0,0 +1,46 @@
+/*
+ * My_RTOS_Queue.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Abdallah
+ */
+
+#ifndef INC_MY_RTOS_QUEUE_H_
+#define INC_MY_RTOS_QUEUE_H_
+
+#include "stdint.h"
+#include "Schedular.h"
+#include "My_RTOS_FIFO.h"
+
+
+// Message queues (MYRTOS_USE_QUEUE): messages of a fixed size are copied in a FIFO on static storage.
+// A receiver waits while the queue is empty and a sender while it is full, both sorted by priority.
+// A message sent to a waiting receiver is copied to its buffer directly (it never passes through the FIFO),
+// and a receiver taking a place moves the message of the first waiting sender into the FIFO
+
+
+// Storage of Length (power of two) messages of MsgSize bytes
+#define MYRTOS_QUEUE_STORAGE(Name, MsgSize, Length)		uint8_t Name[(MsgSize) * (Length)]; \
+														_Static_assert(((Length) & ((Length) - 1)) == 0, #Name ": queue length must be a power of two")
+
+
+#if MYRTOS_USE_QUEUE
+
+typedef struct{
+	FIFO_Buffer_t Messages;            // Not entered by the user
+	struct Task_Config* P_Receivers;   // Not entered by the user (tasks waiting for a message, sorted by priority)
+	struct Task_Config* P_Senders;     // Not entered by the user (tasks waiting for a place, sorted by priority)
+}MYRTOS_Queue_t;
+
+
+MYRTOS_errorID MYRTOS_Queue_Init(MYRTOS_Queue_t* Queue, void* Storage, uint32_t MsgSize, uint32_t Length);
+MYRTOS_errorID MYRTOS_Queue_Send(MYRTOS_Queue_t* Queue, const void* Msg, uint32_t Timeout);
+MYRTOS_errorID MYRTOS_Queue_Receive(MYRTOS_Queue_t* Queue, void* Msg, uint32_t Timeout);
+
+// Messages in the queue
+#define MYRTOS_Queue_Count(Queue)			FIFO_Count(&(Queue)->Messages)
+
+#endif
+
+
+#endif /* INC_MY_RTOS_QUEUE_H_ */
@@ -0,0 +1,43 @@
+/*
+ * My_RTOS_Ring.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Abdallah
+ */
+
+#ifndef INC_MY_RTOS_RING_H_
+#define INC_MY_RTOS_RING_H_
+
+#include "stdint.h"
+#include "Schedular.h"
+
+
+// Lock-free single producer / single consumer ring (MYRTOS_USE_RING), e.g. an interrupt callback pushes and a task pops.
+// The producer only writes tail and the consumer only writes head, so a barrier between the element and its index
+// is enough: no interrupt is disabled and no LDREX/STREX is needed. The consumer can sleep till the next push
+// (waking it needs the producer interrupt at the kernel priority, as the other kernel calls from interrupts)
+
+
+#if MYRTOS_USE_RING
+
+typedef struct{
+	uint8_t* base;                     // Not entered by the user
+	uint32_t element_size;             // Not entered by the user (bytes)
+	uint32_t mask;                     // Not entered by the user (length - 1, length is a power of two)
+	volatile uint32_t head;            // Not entered by the user (next element to pop, written by the consumer)
+	volatile uint32_t tail;            // Not entered by the user (next element to push, written by the producer)
+	struct Task_Config* P_Consumer;    // Not entered by the user (the consumer while it sleeps in MYRTOS_Ring_Pop)
+}MYRTOS_Ring_t;
+
+
+MYRTOS_errorID MYRTOS_Ring_Init(MYRTOS_Ring_t* Ring, void* Buffer, uint32_t element_size, uint32_t length);
+MYRTOS_errorID MYRTOS_Ring_Push(MYRTOS_Ring_t* Ring, const void* Item);
+MYRTOS_errorID MYRTOS_Ring_Pop(MYRTOS_Ring_t* Ring, void* Item, uint32_t Timeout);
+
+// Elements in the ring (a snapshot, exact for the consumer and the producer only)
+#define MYRTOS_Ring_Count(Ring)			((Ring)->tail - (Ring)->head)
+
+#endif
+
+
+#endif /* INC_MY_RTOS_RING_H_ */
@@ -0,0 +1,40 @@
+/*
+ * My_RTOS_Semaphore.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Abdallah
+ */
+
+#ifndef INC_MY_RTOS_SEMAPHORE_H_
+#define INC_MY_RTOS_SEMAPHORE_H_
+
+#include "stdint.h"
+#include "Schedular.h"
+
+
+// Counting semaphores (MYRTOS_USE_SEMAPHORE), binary ones have MaxCount 1. A task takes a count or waits for
+// one (sorted by priority, with a timeout), a give hands the count to the first waiter directly.
+// Giving is callable from interrupts (event signalling), there is no owner and no priority inheritance
+// (the mutexes are for that)
+
+
+#if MYRTOS_USE_SEMAPHORE
+
+typedef struct{
+	uint32_t Count;                    // Not entered by the user
+	uint32_t MaxCount;                 // Not entered by the user
+	struct Task_Config* P_Waiters;     // Not entered by the user (tasks waiting for a count, sorted by priority)
+}MYRTOS_Semaphore_t;
+
+
+MYRTOS_errorID MYRTOS_Semaphore_Init(MYRTOS_Semaphore_t* Semaphore, uint32_t InitialCount, uint32_t MaxCount);
+MYRTOS_errorID MYRTOS_Semaphore_Take(MYRTOS_Semaphore_t* Semaphore, uint32_t Timeout);
+MYRTOS_errorID MYRTOS_Semaphore_Give(MYRTOS_Semaphore_t* Semaphore);
+
+// Counts available now
+#define MYRTOS_Semaphore_Count(Semaphore)			((Semaphore)->Count)
+
+#endif
+
+
+#endif /* INC_MY_RTOS_SEMAPHORE_H_ */
@@ -0,0 +1,94 @@
+/*
+ * My_RTOS_Trace.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Abdallah
+ */
+
+#ifndef INC_MY_RTOS_TRACE_H_
+#define INC_MY_RTOS_TRACE_H_
+
+#include "stdint.h"
+#include "MYRTOS_Config.h"     // Only the configuration, so drivers can trace their interrupt handlers
+
+
+// Scheduler trace recorder (MYRTOS_USE_TRACE): the kernel appends fixed size records to MYRTOS_TraceBuffer (RAM ring),
+// each one is timestamped with the cycle counter of the port (DWT->CYCCNT)
+// Dump MYRTOS_TraceBuffer from the target (e.g. gdb: dump binary value trace.bin MYRTOS_TraceBuffer) or take a whole
+// RAM image, then convert it to a Chrome/Perfetto timeline with Tools/myrtos_trace.py
+
+
+#define MYRTOS_TRACE_MAGIC			0x5254594DUL    // "MYTR"
+#define MYRTOS_TRACE_VERSION		1
+#define MYRTOS_TRACE_NAME_LENGTH	16
+#define MYRTOS_TRACE_NO_TASK		0xFF
+
+
+typedef enum{
+	MYRTOS_TRACE_EMPTY,                // Record not written yet
+	MYRTOS_TRACE_TASK_SWITCH,          // TaskID: switched out, Arg: TaskID switched in
+	MYRTOS_TRACE_SVC,                  // TaskID: caller, Arg: SVC ID
+	MYRTOS_TRACE_MUTEX_TAKE,           // TaskID: new owner (handed off by the release), Arg: mutex (low half of its address)
+	MYRTOS_TRACE_MUTEX_BLOCK,          // TaskID: waiter, Arg: mutex
+	MYRTOS_TRACE_MUTEX_INHERIT,        // TaskID: owner, Arg: its new priority
+	MYRTOS_TRACE_MUTEX_RELEASE,        // TaskID: owner, Arg: mutex
+	MYRTOS_TRACE_TICK,                 // TaskID: current task, Arg: ticks of the period (more than one after tickless idle)
+	MYRTOS_TRACE_ISR_ENTER,            // TaskID: MYRTOS_TRACE_NO_TASK, Arg: IRQ number
+	MYRTOS_TRACE_ISR_EXIT              // TaskID: MYRTOS_TRACE_NO_TASK, Arg: IRQ number
+}MYRTOS_TraceEvent_t;
+
+
+typedef struct{
+	uint32_t Timestamp;                // Cycle counter
+	uint8_t Event;                     // MYRTOS_TraceEvent_t
+	uint8_t TaskID;                    // Order of creation (idle task = 0)
+	uint16_t Arg;
+}MYRTOS_TraceRecord_t;
+
+
+#if MYRTOS_USE_TRACE
+
+#if (MYRTOS_TRACE_RECORDS & (MYRTOS_TRACE_RECORDS - 1)) != 0
+#error "MYRTOS_TRACE_RECORDS must be a power of two"
+#endif
+
+// Layout read by Tools/myrtos_trace.py (little endian, keep MYRTOS_TRACE_VERSION in step)
+typedef struct{
+	uint32_t Magic;                    // MYRTOS_TRACE_MAGIC
+	uint16_t Version;
+	uint16_t RecordSize;
+	uint32_t RecordsNum;               // Capacity of the ring
+	uint32_t CyclesPerUs;
+	volatile uint32_t Head;            // Records written since start (the oldest ones are overwritten)
+	uint16_t TasksNum;                 // Created tasks
+	uint16_t MaxTasks;                 // Entries of TaskNames
+	char TaskNames[MYRTOS_MAX_TASKS][MYRTOS_TRACE_NAME_LENGTH];
+	MYRTOS_TraceRecord_t Records[MYRTOS_TRACE_RECORDS];
+}MYRTOS_TraceBuffer_t;
+
+extern MYRTOS_TraceBuffer_t MYRTOS_TraceBuffer;
+
+
+struct Task_Config;
+
+void MYRTOS_Trace_Init(void);
+void MYRTOS_Trace_TaskCreated(struct Task_Config* taskReference);
+void MYRTOS_Trace_Record(uint8_t Event, uint8_t TaskID, uint16_t Arg);
+void MYRTOS_Trace_ISR(uint8_t Event);
+
+#define MYRTOS_TRACE(Event, P_Task, Arg)	MYRTOS_Trace_Record((Event), ((P_Task) != NULL) ? (P_Task)->TraceID : MYRTOS_TRACE_NO_TASK, (uint16_t)(Arg))
+
+// To be put at the start and at the end of the interrupt handlers to be traced (handler mode)
+#define MYRTOS_TRACE_ISR_ENTER()			MYRTOS_Trace_ISR(MYRTOS_TRACE_ISR_ENTER)
+#define MYRTOS_TRACE_ISR_EXIT()				MYRTOS_Trace_ISR(MYRTOS_TRACE_ISR_EXIT)
+
+#else
+
+#define MYRTOS_TRACE(Event, P_Task, Arg)
+#define MYRTOS_TRACE_ISR_ENTER()
+#define MYRTOS_TRACE_ISR_EXIT()
+
+#endif
+
+
+#endif /* INC_MY_RTOS_TRACE_H_ */
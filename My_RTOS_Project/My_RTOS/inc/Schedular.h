@@ -0,0 +1,175 @@
+/*
+ * Schedular.h
+ *
+ *  Created on: Oct 10, 2023
+ *      Author: Abdallah
+ */
+
+#ifndef INC_SCHEDULAR_H_
+#define INC_SCHEDULAR_H_
+
+#include "MYRTOS_Config.h"
+
+#ifdef MYRTOS_PORT_LINUX
+#include "LinuxOS_Porting.h"      // Host (Linux user space) port, see Host/
+#else
+#include "CortexMxOS_Porting.h"
+#endif
+
+
+#define MYRTOS_IDLE_PRIORITY		(MYRTOS_MAX_PRIORITIES - 1)    // The least priority
+
+// Timeout of the blocking services in ticks (waiting with a timeout needs MYRTOS_USE_TIMING_WAIT, else it waits forever)
+#define MYRTOS_NO_WAIT				0
+#define MYRTOS_WAIT_FOREVER			0xFFFFFFFFUL
+
+
+typedef enum{
+	NO_ERROR,
+	ReadyQueue_Init_Error,
+	Task_Exceeded_Stack_Size,
+	MutexReachedMaximumNumber,        // Not returned anymore (mutexes have wait lists of any length)
+	Mutex_Prevent_Deadlock,
+	Task_Invalid_Priority,
+	Task_Is_Idle,
+	SVC_Invalid_Service,
+	Task_Exceeded_Max_Number,
+	Task_Not_Created,
+	Task_Cant_Be_Deleted,
+	Task_Owns_Mutex,
+	Pool_Invalid_Config,
+	Pool_Invalid_Block,
+	Timeout_Expired,
+	Ring_Invalid_Config,
+	Ring_Full,
+	Ring_Empty,
+	Queue_Invalid_Config,
+	Queue_Full,
+	Queue_Empty,
+	Mail_Invalid_Release,
+	Semaphore_Invalid_Config,
+	Semaphore_Unavailable,
+	Semaphore_Overflow,
+	Mutex_Unavailable,
+	Wait_Cancelled,
+	Mutex_Ceiling_Violation
+}MYRTOS_errorID;
+
+
+typedef struct Task_Config{
+	uint32_t* Current_PSP;        // Not entered by the user (First member, used by PendSV_Handler)
+	uint32_t Stack_Size;
+	uint8_t Priority;
+	uint8_t TableIndex;           // Not entered by the user (place in the scheduler table, OS_Tasks)
+	void (*P_TaskEntry)(void);    // Pointer to the task C function
+	uint32_t _S_PSP_Task;         // Not entered by the user
+	uint32_t _E_PSP_Task;         // Not entered by the user
+#if MYRTOS_USE_TASK_NAMES
+	char TaskName[MYRTOS_NAME_LENGTH];
+#endif
+	enum{
+		Suspend,
+		Waiting,
+		Ready,
+		Running
+	}Task_State;                  // Not entered by the user
+
+#if MYRTOS_USE_TIMING_WAIT
+	struct{
+		enum{
+			Blocking_Disable,
+			Blocking_Enable
+		}Block_Timing;
+		uint32_t Ticks_Count;      // While waiting: ticks after the previous task in the waiting list (delta)
+		struct Task_Config* P_NextWaitingTask;   // Not entered by the user (Waiting list sorted by wake up time)
+		struct Task_Config* P_PrevWaitingTask;   // Not entered by the user
+	}Time_Waiting;
+#endif
+
+	struct Task_Config* P_NextReadyTask;   // Not entered by the user (Ready list of its priority)
+	struct Task_Config* P_PrevReadyTask;   // Not entered by the user
+
+	struct{
+		struct Task_Config** P_WaitList;   // Wait list of the kernel object the task is blocked on (NULL: none)
+		struct Task_Config* P_NextWaiter;  // In that list (sorted by priority)
+		struct Task_Config* P_PrevWaiter;
+		uintptr_t* P_Args;                 // Stacked r0-r3 of its blocking call, the waker writes the result to r0
+	}Object_Waiting;                       // Not entered by the user
+
+#if MYRTOS_USE_MUTEX
+	uint8_t Base_Priority;                 // Not entered by the user (Priority without inheritance)
+	struct Mutex_Config* P_HeldMutexes;    // Not entered by the user (mutexes the task owns, linked by P_NextHeld)
+	struct Mutex_Config* P_BlockingMutex;  // Not entered by the user (the mutex the task waits for, NULL: none)
+#endif
+
+#if MYRTOS_USE_STATISTICS
+	struct{
+		uint32_t SwitchIns;                // Times the task was chosen to run after another task
+		uint64_t RunCycles;                // Cycles the task ran (counted by PendSV_Handler, interrupts included)
+	}Stats;                                // Not entered by the user
+#endif
+
+#if MYRTOS_USE_TRACE
+	uint8_t TraceID;                       // Not entered by the user (order of creation)
+#endif
+
+#if MYRTOS_USE_STACK_WATERMARK
+	uint32_t Stack_HighWater;              // Not entered by the user (bytes of the stack used at most, measured by the idle task)
+#endif
+}Task_Config;
+
+
+#if MYRTOS_USE_MUTEX
+typedef struct Mutex_Config{
+#if MYRTOS_USE_TASK_NAMES
+	char MutexName[MYRTOS_NAME_LENGTH];
+#endif
+	Task_Config* currentTask;
+	Task_Config* P_Waiters;                // Not entered by the user (tasks blocked on the mutex, sorted by priority)
+	struct Mutex_Config* P_NextHeld;       // Not entered by the user (next mutex owned by currentTask)
+	uint8_t* P_Payload;
+	uint8_t Payload_Size;
+	enum{
+		Mutex_Inheritance,                 // The owner inherits the priority of its waiters (default)
+		Mutex_Ceiling                      // The owner runs at Ceiling_Priority from acquiring the mutex (immediate priority ceiling)
+	}Protocol;
+	uint8_t Ceiling_Priority;              // Mutex_Ceiling: the highest priority of the tasks using the mutex
+}Mutex_Config;
+#endif
+
+
+
+// APIs
+
+MYRTOS_errorID MYRTOS_Init(void);
+MYRTOS_errorID MYRTOS_Create_Task(Task_Config* taskReference);
+MYRTOS_errorID MYRTOS_Activate_Task(Task_Config* taskReference);
+MYRTOS_errorID MYRTOS_Terminate_Task(Task_Config* taskReference);
+#if MYRTOS_USE_TASK_DELETE
+MYRTOS_errorID MYRTOS_Delete_Task(Task_Config* taskReference);
+#endif
+#if MYRTOS_USE_TIMING_WAIT
+MYRTOS_errorID MYRTOS_Task_Wait(uint32_t TicksNum, Task_Config* taskReference);
+#endif
+MYRTOS_errorID MYRTOS_Yield(void);
+#if MYRTOS_USE_MUTEX
+MYRTOS_errorID MYRTOS_AcquireMutex(Mutex_Config *Mutex, Task_Config* taskReference);
+MYRTOS_errorID MYRTOS_ReleaseMutex(Mutex_Config *Mutex);
+#endif
+uint32_t MYRTOS_Get_SystemTicks(void);
+Task_Config* MYRTOS_Get_CurrentTask(void);
+#if MYRTOS_USE_STACK_WATERMARK
+uint32_t MYRTOS_Get_StackHighWater(Task_Config* taskReference);
+#endif
+#if MYRTOS_USE_STACK_CHECK
+void MYRTOS_StackOverflow_Hook(Task_Config* taskReference);
+#endif
+#if MYRTOS_USE_STATISTICS
+MYRTOS_errorID MYRTOS_Get_TaskRunTime(Task_Config* taskReference, uint64_t* P_RunCycles, uint64_t* P_TotalCycles);
+uint32_t MYRTOS_Get_TaskUtilization(Task_Config* taskReference);
+uint32_t MYRTOS_Get_IdleUtilization(void);
+#endif
+void MYRTOS_START_OS(void);
+
+
+#endif /* INC_SCHEDULAR_H_ */
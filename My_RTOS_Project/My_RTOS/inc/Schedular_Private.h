@@ -10,7 +10,126 @@
 
 
 
+// Kernel services (index of SVC_Table), called by "svc #0" with the ID in r12 and the arguments in r0-r3,
+// the result is written back to the stacked r0
+typedef enum{
+	SVC_ActivateTask,
+	SVC_TerminateTask,
+#if MYRTOS_USE_TIMING_WAIT
+	SVC_TaskWaitingTime,
+#endif
+#if MYRTOS_USE_MUTEX
+	SVC_AcquireMutex,
+	SVC_ReleaseMutex,
+#endif
+	SVC_Yield,
+	SVC_CreateTask,
+#if MYRTOS_USE_TASK_DELETE
+	SVC_DeleteTask,
+#endif
+#if MYRTOS_USE_MEMPOOL
+	SVC_PoolAlloc,
+	SVC_PoolFree,
+#endif
+#if MYRTOS_USE_RING
+	SVC_RingWait,
+	SVC_RingWake,
+#endif
+#if MYRTOS_USE_QUEUE
+	SVC_QueueSend,
+	SVC_QueueReceive,
+#endif
+#if MYRTOS_USE_MAIL
+	SVC_MailRef,
+#endif
+#if MYRTOS_USE_SEMAPHORE
+	SVC_SemaphoreTake,
+	SVC_SemaphoreGive,
+#endif
+	SVC_ServicesNum
+}SVC_ID;
+
+#define MYRTOS_SVC(ID, Arg0, Arg1)			((MYRTOS_errorID)OS_SVC_CALL((ID), (uintptr_t)(Arg0), (uintptr_t)(Arg1), 0, 0))
+
+// The service was called by an interrupt (the exception number in the stacked xpsr of the caller), it can't block
+#define MYRTOS_CALLED_FROM_ISR(Args)		(((Args)[7] & 0x1FFUL) != 0)
+
+
+// Kernel (Schedular.c)
+typedef uintptr_t (*SVC_Service_t)(uintptr_t* Args);    // Kernel service, Args: the stacked r0-r3
+
 void Decide_WhatNextTask(void);
-void MYRTOS_Update_Tasks_WaitingTime(void);
+void MYRTOS_RoundRobin(void);
+void MYRTOS_Update_Tasks_WaitingTime(uint32_t TicksNum);
+uint32_t MYRTOS_Get_IdleTicks(void);
+void OS_SVC_Services(uintptr_t* StackFramePointer);
+MYRTOS_errorID MYRTOS_Init_Task(Task_Config* taskReference);
+
+// Tasks blocked on kernel objects (pools, ...), the list is sorted by priority
+uint8_t MYRTOS_WaitList_Block(Task_Config** P_WaitList, uintptr_t* Args, uint32_t Timeout);
+Task_Config* MYRTOS_WaitList_Wake(Task_Config** P_WaitList, uintptr_t Result);
+void MYRTOS_WaitList_Remove(Task_Config* taskReference);
+void MYRTOS_WaitList_Insert(Task_Config** P_WaitList, Task_Config* taskReference);
+void MYRTOS_WaitList_Requeue(Task_Config* taskReference);
+
+#if MYRTOS_USE_MUTEX
+// Mutexes, transitive priority inheritance (Schedular.c)
+void MYRTOS_Mutex_UpdatePriority(Task_Config* taskReference);
+void MYRTOS_Mutex_CancelWait(Task_Config* taskReference);
+#endif
+
+#if MYRTOS_USE_MEMPOOL
+// Memory pools (My_RTOS_MemPool.c)
+struct MYRTOS_Pool;
+uintptr_t MYRTOS_SVC_PoolAlloc(uintptr_t* Args);
+uintptr_t MYRTOS_SVC_PoolFree(uintptr_t* Args);
+MYRTOS_errorID MYRTOS_Pool_Put(struct MYRTOS_Pool* Pool, void* Block);
+#endif
+
+#if MYRTOS_USE_RING
+// Lock-free rings (My_RTOS_Ring.c)
+uintptr_t MYRTOS_SVC_RingWait(uintptr_t* Args);
+uintptr_t MYRTOS_SVC_RingWake(uintptr_t* Args);
+#endif
+
+#if MYRTOS_USE_QUEUE
+// Message queues (My_RTOS_Queue.c)
+uintptr_t MYRTOS_SVC_QueueSend(uintptr_t* Args);
+uintptr_t MYRTOS_SVC_QueueReceive(uintptr_t* Args);
+#endif
+
+#if MYRTOS_USE_MAIL
+// Zero-copy mails (My_RTOS_Mail.c)
+uintptr_t MYRTOS_SVC_MailRef(uintptr_t* Args);
+#endif
+
+#if MYRTOS_USE_SEMAPHORE
+// Semaphores (My_RTOS_Semaphore.c)
+uintptr_t MYRTOS_SVC_SemaphoreTake(uintptr_t* Args);
+uintptr_t MYRTOS_SVC_SemaphoreGive(uintptr_t* Args);
+#endif
+
+// PendSV_Handler calls MYRTOS_PendSV_Hook before switching (run time statistics, trace)
+#define MYRTOS_PENDSV_HOOK			(MYRTOS_USE_STATISTICS || MYRTOS_USE_TRACE)
+#if MYRTOS_PENDSV_HOOK
+void MYRTOS_PendSV_Hook(Task_Config* P_Current, Task_Config* P_Next);
+#endif
+
+// Unused stack words hold the pattern (painting), the lowest word of each stack is a guard holding it (stack check)
+#define MYRTOS_STACK_PATTERN		0xA5A5A5A5
+
+#if MYRTOS_USE_STACK_CHECK
+// Offset of _E_PSP_Task in Task_Config for PendSV_Handler (32 bit targets)
+#define MYRTOS_TASK_E_PSP_OFFSET	20
+
+void MYRTOS_Stack_Overflow(Task_Config* P_Task);
+#endif
+
+// Port (CortexMxOS_Porting.c)
+void MYRTOS_Create_Stack(Task_Config* taskReference);
+#if MYRTOS_USE_TASK_DELETE
+void MYRTOS_Delete_Stack(Task_Config* taskReference);
+#endif
+void Start_FirstTask(Task_Config* taskReference);
 
 #endif /* INC_SCHEDULAR_PRIVATE_H_ */
@@ -132,7 +132,7 @@ void task4()
 
 
 // Deadlock
-// Preventing tasks from acquiring more than one mutex to avoid deadlock
+// Deadlock prevention: task5 asking for Mutex2 while task6 (its owner) waits for Mutex1 of task5 is refused
 
 
 
@@ -177,6 +177,7 @@ void task6()
 			MYRTOS_AcquireMutex(&Mutex1, &Task6);
 		}
 		if(counter1 == 100){
+			MYRTOS_ReleaseMutex(&Mutex1);
 			MYRTOS_ReleaseMutex(&Mutex2);
 			MYRTOS_Terminate_Task(&Task6);
 		}
@@ -8,6 +8,7 @@
 
 #include "Stm32_F103C6_EXTI_driver.h"
 #include "Stm32_F103C6_gpio_driver.h"
+#include "My_RTOS_Trace.h"     // Entry / exit of the handlers in the scheduler trace (MYRTOS_USE_TRACE)
 
 
 /*  ****************
@@ -179,6 +180,7 @@ void Update_EXTI(EXTI_PinConfig_t *EXTI_Config)
 	if(EXTI_Config->IRQ_Enable == EXTI_IRQ_Enable)
 	{
 		EXTI->IMR |= (1<<EXTI_Config->EXTI_PIN.EXTI_lineNumber);
+		NVIC_IRQ_SetPriority(EXTI_Config->EXTI_PIN.IVT_IRQ_Number, EXTI_IRQ_PRIORITY);
 		Enable_NVIC(EXTI_Config->EXTI_PIN.EXTI_lineNumber);
 	}else
 	{
@@ -265,6 +267,7 @@ void MCAL_EXTI_GPIO_Update(EXTI_PinConfig_t *EXTI_Config)
 
 void EXTI0_IRQHandler(void)
 {
+	MYRTOS_TRACE_ISR_ENTER();
 
 	// Clear pending register by writing '1' into the bit
 	EXTI->PR |= 1<<0;
@@ -272,66 +275,89 @@ void EXTI0_IRQHandler(void)
 	// Call IRQ_CallBack
 	GP_IRQ_CallBack[0]();
 
+	MYRTOS_TRACE_ISR_EXIT();
 }
 
 
 void EXTI1_IRQHandler(void)
 {
+	MYRTOS_TRACE_ISR_ENTER();
+
 	// Clear pending register by writing '1' into the bit
 	EXTI->PR |= 1<<1;
 
 	// Call IRQ_CallBack
 	GP_IRQ_CallBack[1]();
+
+	MYRTOS_TRACE_ISR_EXIT();
 }
 
 
 void EXTI2_IRQHandler(void)
 {
+	MYRTOS_TRACE_ISR_ENTER();
+
 	// Clear pending register by writing '1' into the bit
 	EXTI->PR |= 1<<2;
 
 	// Call IRQ_CallBack
 	GP_IRQ_CallBack[2]();
+
+	MYRTOS_TRACE_ISR_EXIT();
 }
 
 
 
 void EXTI3_IRQHandler(void)
 {
+	MYRTOS_TRACE_ISR_ENTER();
+
 	// Clear pending register by writing '1' into the bit
 	EXTI->PR |= 1<<3;
 
 	// Call IRQ_CallBack
 	GP_IRQ_CallBack[3]();
+
+	MYRTOS_TRACE_ISR_EXIT();
 }
 
 
 
 void EXTI4_IRQHandler(void)
 {
+	MYRTOS_TRACE_ISR_ENTER();
+
 	// Clear pending register by writing '1' into the bit
 	EXTI->PR |= 1<<4;
 
 	// Call IRQ_CallBack
 	GP_IRQ_CallBack[4]();
+
+	MYRTOS_TRACE_ISR_EXIT();
 }
 
 
 
 void EXTI9_5_IRQHandler(void)
 {
+	MYRTOS_TRACE_ISR_ENTER();
+
 	// First we need to know which one of them was pending
 	if(EXTI->PR & 1<<5){ EXTI->PR |= 1<<5;  GP_IRQ_CallBack[5]();}
 	if(EXTI->PR & 1<<6){ EXTI->PR |= 1<<6;  GP_IRQ_CallBack[6]();}
 	if(EXTI->PR & 1<<7){ EXTI->PR |= 1<<7;  GP_IRQ_CallBack[7]();}
 	if(EXTI->PR & 1<<8){ EXTI->PR |= 1<<8;  GP_IRQ_CallBack[8]();}
 	if(EXTI->PR & 1<<9){ EXTI->PR |= 1<<9;  GP_IRQ_CallBack[9]();}
+
+	MYRTOS_TRACE_ISR_EXIT();
 }
 
 
 
 void EXTI15_10_IRQHandler(void)
 {
+	MYRTOS_TRACE_ISR_ENTER();
+
 	// First we need to know which one of them was pending
 	if(EXTI->PR & 1<<10){ EXTI->PR |= 1<<10;  GP_IRQ_CallBack[10]();}
 	if(EXTI->PR & 1<<11){ EXTI->PR |= 1<<11;  GP_IRQ_CallBack[11]();}
@@ -339,6 +365,8 @@ void EXTI15_10_IRQHandler(void)
 	if(EXTI->PR & 1<<13){ EXTI->PR |= 1<<13;  GP_IRQ_CallBack[13]();}
 	if(EXTI->PR & 1<<14){ EXTI->PR |= 1<<14;  GP_IRQ_CallBack[14]();}
 	if(EXTI->PR & 1<<15){ EXTI->PR |= 1<<15;  GP_IRQ_CallBack[15]();}
+
+	MYRTOS_TRACE_ISR_EXIT();
 }
 
 
@@ -43,6 +43,13 @@ typedef struct
 }EXTI_PinConfig_t;
 
 
+// Priority of the EXTI interrupts: their callbacks may call the RTOS services (e.g. MYRTOS_Pool_Free),
+// so it is OS_KERNEL_PRIORITY of the Cortex-M port (the priority of SysTick and SVC)
+#ifndef EXTI_IRQ_PRIORITY
+#define EXTI_IRQ_PRIORITY		14
+#endif
+
+
 
 // =================================================================================== //
 
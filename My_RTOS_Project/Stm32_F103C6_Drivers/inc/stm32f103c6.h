@@ -39,6 +39,7 @@
 #define NVIC_ICER0								*(volatile uint32_t*)(NVIC_BASE + 0x80)
 #define NVIC_ICER1								*(volatile uint32_t*)(NVIC_BASE + 0x84)
 #define NVIC_ICER2								*(volatile uint32_t*)(NVIC_BASE + 0x88)
+#define NVIC_IPR_BASE							(NVIC_BASE + 0x400)     // One byte for each IRQ
 
 
 //-----------------------------
@@ -249,5 +250,9 @@ typedef struct
 #define NVIC_IRQ40_EXTI10_15_Disable	(NVIC_ICER1 |= (1<<8))    // 40-32
 
 
+// STM32F103 implements the upper 4 bits of each priority byte (0 --> 15)
+#define NVIC_IRQ_SetPriority(IRQ, Priority)	(*(volatile uint8_t*)(NVIC_IPR_BASE + (IRQ)) = (uint8_t)((Priority) << 4))
+
+
 
 #endif /* INC_STM32F103C6_H_ */
@@ -0,0 +1,152 @@
+#!/usr/bin/env python3
+#
+# myrtos_profile.py
+#
+#  Created on: Oct 18, 2026
+#      Author: Abdallah
+#
+# Symbolizes the PC samples of MyRTOS (MYRTOS_Profile, My_RTOS/inc/My_RTOS_Profiler.h) against the executable
+# into a flat profile (functions and tasks) and folded stacks for a flame graph (flamegraph.pl, speedscope)
+#
+#   myrtos_profile.py <dump> --elf My_RTOS_Project.axf [--nm arm-none-eabi-nm] [--folded profile.folded]
+#
+# <dump> is MYRTOS_Profile alone, or any memory image that holds it (the profile is found by its magic):
+#   gdb:   dump binary value profile.bin MYRTOS_Profile
+#   Host:  Host/Build/myrtos_host -p profile.bin  (make -C Host profile)
+
+import argparse
+import bisect
+import collections
+import struct
+import subprocess
+import sys
+
+
+PROFILE_MAGIC = 0x4650594D
+PROFILE_VERSION = 1
+HEADER = struct.Struct("<IHHIII")
+SLOT = struct.Struct("<III")
+IN_HANDLER = 0x1
+
+
+def find_profile(data):
+    """Offset of a valid profile header in data (the dump may be a whole RAM image)."""
+    magic = struct.pack("<I", PROFILE_MAGIC)
+    offset = data.find(magic)
+    while offset >= 0:
+        if offset + HEADER.size <= len(data):
+            fields = HEADER.unpack_from(data, offset)
+            if fields[1] == PROFILE_VERSION and fields[2] == SLOT.size and fields[3] and not fields[3] & (fields[3] - 1):
+                return offset
+        offset = data.find(magic, offset + 1)
+    raise ValueError("no MyRTOS profile (magic 'MYPF', version %d) in the dump" % PROFILE_VERSION)
+
+
+def read_profile(data):
+    offset = find_profile(data)
+    _, _, _, slots_num, samples, dropped = HEADER.unpack_from(data, offset)
+
+    slots_offset = offset + HEADER.size
+    if slots_offset + slots_num * SLOT.size > len(data):
+        raise ValueError("the dump ends inside the profile (%d slots expected)" % slots_num)
+
+    slots = []
+    for index in range(slots_num):
+        pc, task, count = SLOT.unpack_from(data, slots_offset + index * SLOT.size)
+        if count:
+            slots.append((pc, task, count))
+
+    return {"samples": samples, "dropped": dropped, "slots": slots}
+
+
+class Symbols:
+    """Functions and objects of the executable, from nm."""
+
+    def __init__(self, elf, nm):
+        output = subprocess.run([nm, "-n", "-S", "--defined-only", elf], check=True,
+                                stdout=subprocess.PIPE, universal_newlines=True).stdout
+        self.starts, self.functions = [], []
+        self.objects = {}
+        for line in output.splitlines():
+            fields = line.split()
+            if len(fields) == 4:
+                address, size, kind, name = int(fields[0], 16), int(fields[1], 16), fields[2], fields[3]
+            elif len(fields) == 3:
+                address, size, kind, name = int(fields[0], 16), 0, fields[1], fields[2]
+            else:
+                continue
+            if kind in "tTwW":
+                # Thumb functions have bit 0 set
+                self.starts.append(address & ~1)
+                self.functions.append((address & ~1, size, name))
+            elif kind in "bBdD":
+                self.objects[address] = name
+
+    def function(self, pc):
+        if pc == 0:
+            return "[outside the executable]"
+        index = bisect.bisect_right(self.starts, pc) - 1
+        if index < 0:
+            return "[unknown 0x%08x]" % pc
+        start, size, name = self.functions[index]
+        if size and pc >= start + size:
+            return "[unknown 0x%08x]" % pc
+        return name
+
+    def task(self, address):
+        if address == 0:
+            return "[no task]"
+        return self.objects.get(address, "task@0x%08x" % address)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="MyRTOS PC samples to a flat profile and a flame graph")
+    parser.add_argument("dump", help="MYRTOS_Profile dump or memory image")
+    parser.add_argument("--elf", required=True, help="the executable that ran (My_RTOS_Project.axf)")
+    parser.add_argument("--nm", default="arm-none-eabi-nm", help="nm of the toolchain (default: arm-none-eabi-nm)")
+    parser.add_argument("--folded", help="writes the folded stacks (task;[handler];function samples)")
+    parser.add_argument("--top", type=int, default=25, help="functions in the flat profile (default: 25)")
+    options = parser.parse_args()
+
+    with open(options.dump, "rb") as dump:
+        data = dump.read()
+
+    try:
+        profile = read_profile(data)
+    except ValueError as error:
+        sys.exit("myrtos_profile: %s" % error)
+
+    symbols = Symbols(options.elf, options.nm)
+
+    functions = collections.Counter()
+    tasks = collections.Counter()
+    stacks = collections.Counter()
+    for pc, task, count in profile["slots"]:
+        function = symbols.function(pc)
+        task_name = symbols.task(task & ~IN_HANDLER)
+        functions[function] += count
+        tasks[task_name] += count
+        stacks[";".join([task_name] + (["[handler]"] if task & IN_HANDLER else []) + [function])] += count
+
+    total = sum(functions.values()) or 1
+    print("%d samples" % profile["samples"])
+    if profile["dropped"]:
+        print("%d samples dropped, the table was full (enlarge MYRTOS_PROFILER_SLOTS)" % profile["dropped"])
+    print("")
+
+    print("%9s %7s  %s" % ("Samples", "%", "Function"))
+    for function, count in functions.most_common(options.top):
+        print("%9d %7.2f  %s" % (count, 100.0 * count / total, function))
+
+    print("\n%9s %7s  %s" % ("Samples", "%", "Task"))
+    for task_name, count in tasks.most_common():
+        print("%9d %7.2f  %s" % (count, 100.0 * count / total, task_name))
+
+    if options.folded:
+        with open(options.folded, "w") as folded:
+            for stack, count in sorted(stacks.items()):
+                folded.write("%s %d\n" % (stack, count))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,177 @@
+#!/usr/bin/env python3
+#
+# myrtos_trace.py
+#
+#  Created on: Oct 18, 2026
+#      Author: Abdallah
+#
+# Converts the scheduler trace of MyRTOS (MYRTOS_TraceBuffer, My_RTOS/inc/My_RTOS_Trace.h) to a Chrome trace
+# (JSON), open it in ui.perfetto.dev or chrome://tracing
+#
+#   myrtos_trace.py <dump> [-o trace.json]
+#
+# <dump> is MYRTOS_TraceBuffer alone, or any memory image that holds it (the buffer is found by its magic):
+#   gdb:   dump binary value trace.bin MYRTOS_TraceBuffer
+#   QEMU:  (gdb stub, -s) the same gdb command, or "dump binary memory ram.bin 0x20000000 0x20010000"
+#   Host:  Host/Build/myrtos_sim <scenario> -t trace.bin  (make -C Host trace)
+
+import argparse
+import json
+import struct
+import sys
+
+
+TRACE_MAGIC = 0x5254594D
+TRACE_VERSION = 1
+HEADER = struct.Struct("<IHHIIIHH")
+RECORD = struct.Struct("<IBBH")
+NAME_LENGTH = 16
+NO_TASK = 0xFF
+
+(EV_EMPTY, EV_TASK_SWITCH, EV_SVC, EV_MUTEX_TAKE, EV_MUTEX_BLOCK, EV_MUTEX_INHERIT,
+ EV_MUTEX_RELEASE, EV_TICK, EV_ISR_ENTER, EV_ISR_EXIT) = range(10)
+
+# SVC_ID of Schedular_Private.h with every feature enabled (the Host build)
+SVC_NAMES = ["ActivateTask", "TerminateTask", "TaskWaitingTime", "AcquireMutex", "ReleaseMutex", "Yield", "CreateTask", "DeleteTask",
+             "PoolAlloc", "PoolFree", "RingWait", "RingWake", "QueueSend", "QueueReceive", "MailRef",
+             "SemaphoreTake", "SemaphoreGive"]
+
+PID = 1
+TID_KERNEL = 1000
+TID_ISR = 1001
+
+
+def find_buffer(data):
+    """Offset of a valid trace header in data (the dump may be a whole RAM image)."""
+    magic = struct.pack("<I", TRACE_MAGIC)
+    offset = data.find(magic)
+    while offset >= 0:
+        if offset + HEADER.size <= len(data):
+            fields = HEADER.unpack_from(data, offset)
+            if fields[1] == TRACE_VERSION and fields[2] == RECORD.size and fields[3] and not fields[3] & (fields[3] - 1):
+                return offset
+        offset = data.find(magic, offset + 1)
+    raise ValueError("no MyRTOS trace buffer (magic 'MYTR', version %d) in the dump" % TRACE_VERSION)
+
+
+def read_trace(data):
+    offset = find_buffer(data)
+    _, _, _, records_num, cycles_per_us, head, tasks_num, max_tasks = HEADER.unpack_from(data, offset)
+
+    names_offset = offset + HEADER.size
+    names = []
+    for task_id in range(max_tasks):
+        raw = data[names_offset + task_id * NAME_LENGTH: names_offset + (task_id + 1) * NAME_LENGTH]
+        name = raw.split(b"\0", 1)[0].decode("ascii", "replace")
+        names.append(name if name else "task_%d" % task_id)
+
+    records_offset = names_offset + max_tasks * NAME_LENGTH
+    if records_offset + records_num * RECORD.size > len(data):
+        raise ValueError("the dump ends inside the trace buffer (%d records expected)" % records_num)
+
+    # Oldest first: the ring wrapped once more than records_num records were written
+    if head <= records_num:
+        order = range(head)
+    else:
+        first = head % records_num
+        order = list(range(first, records_num)) + list(range(first))
+
+    records = []
+    for index in order:
+        record = RECORD.unpack_from(data, records_offset + index * RECORD.size)
+        if record[1] != EV_EMPTY:
+            records.append(record)
+
+    return {
+        "cycles_per_us": cycles_per_us or 1,
+        "names": names[:max(tasks_num, 1)],
+        "records": records,
+        "lost": max(head - records_num, 0),
+    }
+
+
+def task_name(trace, task_id):
+    if task_id == NO_TASK:
+        return "none"
+    if task_id < len(trace["names"]):
+        return trace["names"][task_id]
+    return "task_%d" % task_id
+
+
+def to_chrome(trace):
+    events = [{"ph": "M", "pid": PID, "name": "process_name", "args": {"name": "MyRTOS"}},
+              {"ph": "M", "pid": PID, "tid": TID_KERNEL, "name": "thread_name", "args": {"name": "Kernel"}},
+              {"ph": "M", "pid": PID, "tid": TID_ISR, "name": "thread_name", "args": {"name": "Interrupts"}}]
+    for task_id, name in enumerate(trace["names"]):
+        events.append({"ph": "M", "pid": PID, "tid": task_id, "name": "thread_name", "args": {"name": name}})
+        events.append({"ph": "M", "pid": PID, "tid": task_id, "name": "thread_sort_index", "args": {"sort_index": task_id}})
+
+    def instant(time, tid, name, args):
+        events.append({"ph": "i", "s": "t", "pid": PID, "tid": tid, "ts": time, "name": name, "args": args})
+
+    running, running_since = None, 0.0
+    cycles, previous = 0, None
+    time = 0.0
+
+    for timestamp, event, task_id, arg in trace["records"]:
+        # The cycle counter is 32 bit: records are less than one wrap apart (a tick is recorded every 2 s at least)
+        if previous is not None:
+            cycles += (timestamp - previous) & 0xFFFFFFFF
+        previous = timestamp
+        time = cycles / trace["cycles_per_us"]
+
+        if event == EV_TASK_SWITCH:
+            if running is not None:
+                events.append({"ph": "X", "pid": PID, "tid": running, "ts": running_since,
+                               "dur": time - running_since, "name": task_name(trace, running)})
+            running, running_since = arg, time
+        elif event == EV_SVC:
+            name = SVC_NAMES[arg] if arg < len(SVC_NAMES) else "SVC %d" % arg
+            instant(time, task_id if task_id != NO_TASK else TID_KERNEL, "SVC " + name, {"id": arg})
+        elif event in (EV_MUTEX_TAKE, EV_MUTEX_BLOCK, EV_MUTEX_RELEASE):
+            name = {EV_MUTEX_TAKE: "Mutex take", EV_MUTEX_BLOCK: "Mutex block", EV_MUTEX_RELEASE: "Mutex release"}[event]
+            instant(time, task_id, name, {"mutex": "0x%04x" % arg})
+        elif event == EV_MUTEX_INHERIT:
+            instant(time, task_id, "Priority inherit", {"priority": arg})
+        elif event == EV_TICK:
+            instant(time, TID_KERNEL, "Tick", {"ticks": arg, "task": task_name(trace, task_id)})
+        elif event in (EV_ISR_ENTER, EV_ISR_EXIT):
+            events.append({"ph": "B" if event == EV_ISR_ENTER else "E", "pid": PID, "tid": TID_ISR,
+                           "ts": time, "name": "IRQ %d" % arg})
+
+    if running is not None:
+        events.append({"ph": "X", "pid": PID, "tid": running, "ts": running_since,
+                       "dur": time - running_since, "name": task_name(trace, running)})
+
+    return {"traceEvents": events, "displayTimeUnit": "ms",
+            "otherData": {"records": len(trace["records"]), "lost": trace["lost"]}}
+
+
+def main():
+    parser = argparse.ArgumentParser(description="MyRTOS scheduler trace to Chrome/Perfetto JSON")
+    parser.add_argument("dump", help="MYRTOS_TraceBuffer dump or memory image")
+    parser.add_argument("-o", "--output", help="JSON file (default: stdout)")
+    options = parser.parse_args()
+
+    with open(options.dump, "rb") as dump:
+        data = dump.read()
+
+    try:
+        trace = read_trace(data)
+    except ValueError as error:
+        sys.exit("myrtos_trace: %s" % error)
+
+    chrome = to_chrome(trace)
+
+    if options.output:
+        with open(options.output, "w") as output:
+            json.dump(chrome, output)
+    else:
+        json.dump(chrome, sys.stdout)
+
+    print("myrtos_trace: %d records, %d tasks, %d lost (ring overwritten)"
+          % (len(trace["records"]), len(trace["names"]), trace["lost"]), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()